@@ -2,9 +2,9 @@
 
 #include "Action.hh"
 
-Action::Action (istream& is) {
-  u.clear();
-  v.clear();
+const int Action::MAX_STAMPED;
+
+Action::Action (istream& is) : q(0), epoch(1) {
 
   // warning: all read operations must be checked for SecGame.
   int l;
@@ -14,8 +14,7 @@ Action::Action (istream& is) {
     is >> i;
     char c, d;
     if (is >> c >> d) {
-      u.insert(i);
-      v.push_back(Command(i, char2CommandType(c), char2Dir(d)));
+      if (not has_command(i)) add_command(Command(i, char2CommandType(c), char2Dir(d)));
     }
     else {
       //cerr << "warning: only partially read command for citizen " << i << endl;
@@ -24,11 +23,32 @@ Action::Action (istream& is) {
   }
 }
 
+Action::Action (const Action& a) : q(0), epoch(1) {
+  *this = a;
+}
+
+Action& Action::operator= (const Action& a) {
+  if (this == &a) return *this;
+  clear();
+  q = a.q;
+  for (const Command& m : a.v) add_command(m);
+  return *this;
+}
+
+void Action::clear () {
+  q = 0;
+  v.clear();
+  if (++epoch == 0) { // Wrapped around: stamps of long ago could match again.
+    fill(stamp.begin(), stamp.end(), 0);
+    epoch = 1;
+  }
+}
+
 void Action::print (const vector<Command>& commands, ostream& os) {
-  os << commands.size() << endl;
+  os << commands.size() << '\n';
   for (const Command& com : commands)
     os <<                  com.id       << '\t'
        << CommandType2char(com.c_type)  << '\t'
        <<         Dir2char(com.dir   )  << '\t'
-       << endl;
+       << '\n';
 }
@@ -34,7 +34,13 @@ public:
   /**
    * Empty constructor.
    */
-  Action () : q(0) { }
+  Action () : q(0), epoch(1) { }
+
+  /**
+   * Copies the commands. Assignment reuses the memory of this action.
+   */
+  Action (const Action& a);
+  Action& operator= (const Action& a);
  
  
 private:
@@ -42,6 +48,9 @@ private:
   friend class Game;
   friend class SecGame;
   friend class Board;
+  friend class Replay;
+  friend class Player;
+  friend class Legacy_player;
 
   /**
    * Maximum number of commands allowed for a player during one round.
@@ -54,15 +63,39 @@ private:
   int q;
   
   /**
-   * Set of citizens that have already performed a command.
+   * Identifiers below this are marked in stamp; others are looked for in v.
+   * Identifiers of citizens always are (see Board::create_new_citizen).
+   */
+  static const int MAX_STAMPED = SHRT_MAX + 1;
+
+  /**
+   * Citizen id already has a command iff stamp[id] == epoch. A new epoch
+   * forgets all the commands without touching stamp, so that the memory
+   * of an action is reused from round to round.
    */
-  set<int> u;
+  vector<unsigned> stamp;
+  unsigned         epoch;
 
   /**
    * List of commands to be performed during this round.
    */
   vector<Command> v;
 
+  /**
+   * Returns whether there is already a command for citizen id.
+   */
+  bool has_command (int id) const;
+
+  /**
+   * Adds m, whose citizen has no command yet.
+   */
+  void add_command (const Command& m);
+
+  /**
+   * Removes all the commands, keeping the memory.
+   */
+  void clear ();
+
   /**
    * Read/write commands to/from a stream.
    */
@@ -104,11 +137,25 @@ inline void Action::execute(const Command& m) {
   ++q;
   _my_assert(q <= MAX_COMMANDS, "Too many commands.");  
   
-  if (u.find(m.id) != u.end()) {
+  if (has_command(m.id)) {
     //cerr << "warning: command already requested for citizen " << m.id << endl;
     return;
   }
-  u.insert(m.id);
+  add_command(m);
+}
+
+inline bool Action::has_command (int id) const {
+  if (id >= 0 and id < MAX_STAMPED) return id < (int)stamp.size() and stamp[id] == epoch;
+  for (const Command& m : v)
+    if (m.id == id) return true;
+  return false;
+}
+
+inline void Action::add_command (const Command& m) {
+  if (m.id >= 0 and m.id < MAX_STAMPED) {
+    if (m.id >= (int)stamp.size()) stamp.resize(min(MAX_STAMPED, max(m.id + 1, 2*(int)stamp.size())), 0);
+    stamp[m.id] = epoch;
+  }
   v.push_back(m);
 }
 
@@ -7,25 +7,26 @@ void Board::create_new_citizen(Pos p, CitizenType t, int pl) {
   int id = fresh_id;
   ++fresh_id;
   _my_assert(not citizens.count(id), "Identifier is not fresh.");
+  _my_assert(id <= SHRT_MAX, "Identifier does not fit in the grid.");
 
-  citizens[id] = Citizen(t, id, pl, p, (t == Builder ? NoWeapon : Hammer), citizen_ini_life(t));
+  citizens.insert(Citizen(t, id, pl, p, (t == Builder ? NoWeapon : Hammer), citizen_ini_life(t)));
 
   _my_assert(grid[p.i][p.j].is_empty(),        "Cell is already full.");
 
   grid[p.i][p.j].id = id;
 
-  if      (t == Builder) player2builders[pl].insert(id);
-  else                  player2warriors [pl].insert(id);
+  if      (t == Builder) sorted_insert(player2builders[pl], id);
+  else                  sorted_insert(player2warriors [pl], id);
 }
 
 
-Board::Board(istream& is, int seed) {
+Board::Board(istream& is, int seed) : generation_attempts(0), journal(0) {
   set_random_seed(seed);
   *static_cast<Settings*>(this) = Settings::read_settings(is);
 
-  player2builders   = vector<set<int>>(num_players());
-  player2warriors   = vector<set<int>>(num_players());
-  player2barricades = vector<set<Pos>>(num_players());
+  player2builders   = vector<vector<int>>(num_players());
+  player2warriors   = vector<vector<int>>(num_players());
+  player2barricades = vector<vector<Pos>>(num_players());
   
   names          = vector<string>(num_players());
   scr            = vector<int>   (num_players(), 0);
@@ -35,14 +36,87 @@ Board::Board(istream& is, int seed) {
   day = true;
 
   fresh_id = 0;
+  validation = default_validation;
   read_generator_and_grid(is);
 
-  for (auto& p : citizens) fresh_id = max(fresh_id,p.first);
+  for (const Citizen& ci : citizens) fresh_id = max(fresh_id,ci.id);
   ++fresh_id;
+
+  // As checked by read_settings, but for the identifiers of a fixed board.
+  _my_assert(fresh_id + max_new_citizens() <= SHRT_MAX + 1LL,
+             "Too many citizens can be created in a match for their identifiers to fit in the grid.");
   
   _my_assert(ok(), "Invariants are not satisfied.");
 }
 
+Board::Board (const Info& info, int seed) :
+  Info(info),
+  names(info.num_players()),
+  fresh_id(0),
+  validation(default_validation),
+  generation_attempts(0),
+  journal(0) {
+
+  set_random_seed(seed);
+  for (const Citizen& ci : citizens) fresh_id = max(fresh_id,ci.id);
+  ++fresh_id;
+}
+
+
+void Board::save (Snapshot& s) const {
+  // Only copies the cells changed since s was last saved from this board, if it was.
+  s.state.update(*this);
+  s.rnd_seed               = rnd_seed;
+  s.fresh_id               = fresh_id;
+  s.bonus_to_regenerate    = bonus_to_regenerate;
+  s.weapons_to_regenerate  = weapons_to_regenerate;
+  s.citizens_to_regenerate = citizens_to_regenerate;
+  s.regen_positions        = regen_positions;
+}
+
+
+void Board::restore (const Snapshot& s) {
+  // A full copy of the state: an incremental one (State::update) would
+  // not undo the cells written by this board since it was saved.
+  *static_cast<State*>(this) = s.state;
+  rnd_seed               = s.rnd_seed;
+  fresh_id               = s.fresh_id;
+  bonus_to_regenerate    = s.bonus_to_regenerate;
+  weapons_to_regenerate  = s.weapons_to_regenerate;
+  citizens_to_regenerate = s.citizens_to_regenerate;
+  regen_positions        = s.regen_positions;
+}
+
+
+void Board::read_generator_and_grid (istream& is) {
+  string generator;
+  is >> generator;
+  if (generator == "FIXED") {
+    read_grid(is);
+    check_is_good_initial_fixed_board();
+    return;
+  }
+  _my_assert(generator == "RANDOM" or generator == "FAST", "unknown generator  " + generator);
+
+  string line;
+  getline(is, line);
+  istringstream ls(line);
+  int percent = 20, num_streets = 5;
+  if (ls >> percent) ls >> num_streets;
+  _my_assert(percent >= 0 and percent <= 50, "The percentage of building cells should be in [0,50].");
+  _my_assert(num_streets >= 1 and num_streets <= board_rows()*board_cols()/25, "Wrong number of streets.");
+
+  // Also if all the building cells are placed.
+  int num_items = num_players()*(num_ini_builders() + num_ini_warriors())
+    + num_ini_food() + num_ini_money() + num_ini_guns() + num_ini_bazookas();
+  _my_assert(num_items <= board_rows()*board_cols()*(100 - percent)/100,
+             "Not enough room in the board for all the citizens, bonus and weapons.");
+
+  if (generator == "RANDOM") generate_random_board(percent, num_streets);
+  else                       generate_fast_random_board(percent, num_streets);
+}
+
+
 void Board::check_is_good_initial_fixed_board () const {
   int num_builders = 0;
   int num_warriors = 0;
@@ -53,8 +127,8 @@ void Board::check_is_good_initial_fixed_board () const {
 
   vector<int> n_barricades(num_players(),0);
 
-  _my_assert(int(grid.size()) == board_rows(), "Fixed board has wrong number of rows.");
-  _my_assert(int(grid[0].size()) == board_cols(), "Fixed board has wrong number of cols.");
+  _my_assert(grid.rows() == board_rows(), "Fixed board has wrong number of rows.");
+  _my_assert(grid.cols() == board_cols(), "Fixed board has wrong number of cols.");
   
   
   // Count everything
@@ -63,7 +137,7 @@ void Board::check_is_good_initial_fixed_board () const {
   // Barricades with proper resistance  
   for (int i = 0; i < board_rows(); ++i)
     for (int j = 0; j < board_cols(); ++j) {
-      Cell c = grid[i][j];
+      const Packed_cell& c = grid[i][j];
       if (c.bonus == Food) ++num_food;
       else if (c.bonus == Money) ++num_money;
       else if (c.weapon == Gun) ++num_guns;
@@ -106,42 +180,42 @@ void Board::check_is_good_initial_fixed_board () const {
 
 void Board::print_settings (ostream& os) const {
 
-  os <<   version()                                                          << endl;
-  os                                                                         << endl;
-  os <<  "NUM_PLAYERS"               << "\t" <<  num_players()               << endl;
-  os <<  "NUM_DAYS"                  << "\t" <<  num_days()                  << endl;
-  os <<  "NUM_ROUNDS_PER_DAY"        << "\t" <<  num_rounds_per_day()        << endl;
-  os <<  "BOARD_ROWS"                << "\t" <<  board_rows()                << endl;
-  os <<  "BOARD_COLS"                << "\t" <<  board_cols()                << endl;
-  os <<  "NUM_INI_BUILDERS"          << "\t" <<  num_ini_builders()          << endl;
-  os <<  "NUM_INI_WARRIORS"          << "\t" <<  num_ini_warriors()          << endl;
-  os <<  "NUM_INI_MONEY"             << "\t" <<  num_ini_money()             << endl;
-  os <<  "NUM_INI_FOOD"              << "\t" <<  num_ini_food()              << endl;
-  os <<  "NUM_INI_GUNS"              << "\t" <<  num_ini_guns()              << endl;
-  os <<  "NUM_INI_BAZOOKAS"          << "\t" <<  num_ini_bazookas()          << endl;
-  os <<  "BUILDER_INI_LIFE"          << "\t" <<  builder_ini_life()          << endl;
-  os <<  "WARRIOR_INI_LIFE"          << "\t" <<  warrior_ini_life()          << endl;
-  os <<  "MONEY_POINTS"              << "\t" <<  money_points()              << endl;
-  os <<  "KILL_BUILDER_POINTS"       << "\t" <<  kill_builder_points()       << endl;
-  os <<  "KILL_WARRIOR_POINTS"       << "\t" <<  kill_warrior_points()       << endl;
-  os <<  "FOOD_INCR_LIFE"            << "\t" <<  food_incr_life()            << endl;
-  os <<  "LIFE_LOST_IN_ATTACK"       << "\t" <<  life_lost_in_attack()       << endl;
-  os <<  "BUILDER_STRENGTH_ATTACK"   << "\t" <<  builder_strength_attack()   << endl;
-  os <<  "HAMMER_STRENGTH_ATTACK"    << "\t" <<  hammer_strength_attack()    << endl;
-  os <<  "GUN_STRENGTH_ATTACK"       << "\t" <<  gun_strength_attack()       << endl;
-  os <<  "BAZOOKA_STRENGTH_ATTACK"   << "\t" <<  bazooka_strength_attack()   << endl;
-  os <<  "BUILDER_STRENGTH_DEMOLISH" << "\t" <<  builder_strength_demolish() << endl;
-  os <<  "HAMMER_STRENGTH_DEMOLISH"  << "\t" <<  hammer_strength_demolish()  << endl;
-  os <<  "GUN_STRENGTH_DEMOLISH"     << "\t" <<  gun_strength_demolish()     << endl;
-  os <<  "BAZOOKA_STRENGTH_DEMOLISH" << "\t" <<  bazooka_strength_demolish() << endl;
-  os <<  "NUM_ROUNDS_REGEN_BUILDER"  << "\t" <<  num_rounds_regen_builder()  << endl;
-  os <<  "NUM_ROUNDS_REGEN_WARRIOR"  << "\t" <<  num_rounds_regen_warrior()  << endl;
-  os <<  "NUM_ROUNDS_REGEN_FOOD"     << "\t" <<  num_rounds_regen_food()     << endl;
-  os <<  "NUM_ROUNDS_REGEN_MONEY"    << "\t" <<  num_rounds_regen_money()    << endl;
-  os <<  "NUM_ROUNDS_REGEN_WEAPON"   << "\t" <<  num_rounds_regen_weapon()   << endl;
-  os <<  "BARRICADE_RESISTANCE_STEP" << "\t" <<  barricade_resistance_step() << endl;
-  os <<  "BARRICADE_MAX_RESISTANCE"  << "\t" <<  barricade_max_resistance()  << endl;
-  os <<  "MAX_NUM_BARRICADES"        << "\t" <<  max_num_barricades()        << endl;
+  os <<   version()                                                          << '\n';
+  os                                                                         << '\n';
+  os <<  "NUM_PLAYERS"               << "\t" <<  num_players()               << '\n';
+  os <<  "NUM_DAYS"                  << "\t" <<  num_days()                  << '\n';
+  os <<  "NUM_ROUNDS_PER_DAY"        << "\t" <<  num_rounds_per_day()        << '\n';
+  os <<  "BOARD_ROWS"                << "\t" <<  board_rows()                << '\n';
+  os <<  "BOARD_COLS"                << "\t" <<  board_cols()                << '\n';
+  os <<  "NUM_INI_BUILDERS"          << "\t" <<  num_ini_builders()          << '\n';
+  os <<  "NUM_INI_WARRIORS"          << "\t" <<  num_ini_warriors()          << '\n';
+  os <<  "NUM_INI_MONEY"             << "\t" <<  num_ini_money()             << '\n';
+  os <<  "NUM_INI_FOOD"              << "\t" <<  num_ini_food()              << '\n';
+  os <<  "NUM_INI_GUNS"              << "\t" <<  num_ini_guns()              << '\n';
+  os <<  "NUM_INI_BAZOOKAS"          << "\t" <<  num_ini_bazookas()          << '\n';
+  os <<  "BUILDER_INI_LIFE"          << "\t" <<  builder_ini_life()          << '\n';
+  os <<  "WARRIOR_INI_LIFE"          << "\t" <<  warrior_ini_life()          << '\n';
+  os <<  "MONEY_POINTS"              << "\t" <<  money_points()              << '\n';
+  os <<  "KILL_BUILDER_POINTS"       << "\t" <<  kill_builder_points()       << '\n';
+  os <<  "KILL_WARRIOR_POINTS"       << "\t" <<  kill_warrior_points()       << '\n';
+  os <<  "FOOD_INCR_LIFE"            << "\t" <<  food_incr_life()            << '\n';
+  os <<  "LIFE_LOST_IN_ATTACK"       << "\t" <<  life_lost_in_attack()       << '\n';
+  os <<  "BUILDER_STRENGTH_ATTACK"   << "\t" <<  builder_strength_attack()   << '\n';
+  os <<  "HAMMER_STRENGTH_ATTACK"    << "\t" <<  hammer_strength_attack()    << '\n';
+  os <<  "GUN_STRENGTH_ATTACK"       << "\t" <<  gun_strength_attack()       << '\n';
+  os <<  "BAZOOKA_STRENGTH_ATTACK"   << "\t" <<  bazooka_strength_attack()   << '\n';
+  os <<  "BUILDER_STRENGTH_DEMOLISH" << "\t" <<  builder_strength_demolish() << '\n';
+  os <<  "HAMMER_STRENGTH_DEMOLISH"  << "\t" <<  hammer_strength_demolish()  << '\n';
+  os <<  "GUN_STRENGTH_DEMOLISH"     << "\t" <<  gun_strength_demolish()     << '\n';
+  os <<  "BAZOOKA_STRENGTH_DEMOLISH" << "\t" <<  bazooka_strength_demolish() << '\n';
+  os <<  "NUM_ROUNDS_REGEN_BUILDER"  << "\t" <<  num_rounds_regen_builder()  << '\n';
+  os <<  "NUM_ROUNDS_REGEN_WARRIOR"  << "\t" <<  num_rounds_regen_warrior()  << '\n';
+  os <<  "NUM_ROUNDS_REGEN_FOOD"     << "\t" <<  num_rounds_regen_food()     << '\n';
+  os <<  "NUM_ROUNDS_REGEN_MONEY"    << "\t" <<  num_rounds_regen_money()    << '\n';
+  os <<  "NUM_ROUNDS_REGEN_WEAPON"   << "\t" <<  num_rounds_regen_weapon()   << '\n';
+  os <<  "BARRICADE_RESISTANCE_STEP" << "\t" <<  barricade_resistance_step() << '\n';
+  os <<  "BARRICADE_MAX_RESISTANCE"  << "\t" <<  barricade_max_resistance()  << '\n';
+  os <<  "MAX_NUM_BARRICADES"        << "\t" <<  max_num_barricades()        << '\n';
 
 }
 
@@ -149,31 +223,31 @@ void Board::print_settings (ostream& os) const {
 void Board::print_names (ostream& os) const {
   os << "names         ";
   for (int pl = 0; pl < num_players(); ++pl) os << ' ' << name(pl);
-  os << endl;
+  os << '\n';
 }
 
 
-void Board::print_state (ostream& os) {
+void Board::print_state (ostream& os) const {
 
   // Should start with the same format of Info::read_grid.
   // Then other data describing the state.
 
-  os << endl << endl;
+  os << '\n' << '\n';
 
   os << "   ";
   for (int j = 0; j < board_cols(); ++j)
-    os << j / 10;
-  os << endl;
+    os << j / 10 % 10; // One character per column, also beyond 100.
+  os << '\n';
 
   os << "   ";
   for (int j = 0; j < board_cols(); ++j)
     os << j % 10;
-  os << endl;
+  os << '\n';
 
   for (int i = 0; i < board_rows(); ++i) {
     os << i / 10 << i % 10 << " ";
     for (int j = 0; j < board_cols(); ++j) {
-      const Cell& c = grid[i][j];
+      const Packed_cell& c = grid[i][j];
       if      (c.type   == Building) os << 'B';
       else if (c.weapon == Gun)      os << 'G';
       else if (c.weapon == Bazooka)  os << 'Z';
@@ -192,103 +266,120 @@ void Board::print_state (ostream& os) {
       else if (c.resistance != -1) os << 'b'; // barricade with no citizen
       else                           os << '.';
     }
-    os << endl;
+    os << '\n';
   }
 
-  os << endl << "citizens" << endl;
-  os << citizens.size() << endl;
-  os << "type\tid\tplayer\trow\tcolumn\tweapon\tlife" << endl;
-  for (const auto& ci : citizens) {
-    os << CitizenType2char(ci.second.type) << "\t";
-    os << ci.second.id << "\t";
-    os << ci.second.player << "\t";
-    os << ci.second.pos.i << "\t";
-    os << ci.second.pos.j << "\t";
-    os << WeaponType2char(ci.second.weapon) << "\t";
-    os << ci.second.life << endl;
+  os << '\n' << "citizens" << '\n';
+  os << citizens.size() << '\n';
+  os << "type\tid\tplayer\trow\tcolumn\tweapon\tlife" << '\n';
+  for (const Citizen& ci : citizens) {
+    os << CitizenType2char(ci.type) << "\t";
+    os << ci.id << "\t";
+    os << ci.player << "\t";
+    os << ci.pos.i << "\t";
+    os << ci.pos.j << "\t";
+    os << WeaponType2char(ci.weapon) << "\t";
+    os << ci.life << '\n';
   }
 
-  os << endl << "barricades" << endl;
+  os << '\n' << "barricades" << '\n';
   // Collect them
   vector<Pos> barricades;
   for (int i = 0; i < board_rows(); ++i)
     for (int j = 0; j < board_cols(); ++j)
       if (grid[i][j].resistance != -1) barricades.push_back(Pos(i,j));
-  os << barricades.size() << endl;
-  os << "player\trow\tcolumn\tresistance" << endl;
+  os << barricades.size() << '\n';
+  os << "player\trow\tcolumn\tresistance" << '\n';
   for (const auto& p : barricades) {
-    os << grid[p.i][p.j].b_owner << "\t";
+    os << int(grid[p.i][p.j].b_owner) << "\t";
     os << p.i << "\t";
     os << p.j << "\t";
-    os << grid[p.i][p.j].resistance << endl;
+    os << grid[p.i][p.j].resistance << '\n';
   }
 
-  os << endl;
+  os << '\n';
 
-  os << "round " << rnd << endl;
-  os << "day " << day << endl;
-  os << endl;
+  os << "round " << rnd << '\n';
+  os << "day " << day << '\n';
+  os << '\n';
 
   os << "score";
   for (auto s : scr) os << "\t" << s;
-  os << endl;
+  os << '\n';
 
-  os << endl;
+  os << '\n';
 
   os << "status";
   for (auto s : stats) os << "\t" << s;
-  os << endl;
-
-  os << endl;
+  os << '\n';
+
+  os << '\n';
+
+  // Pending regenerations, in the order they will be processed.
+  // Kind is (c)itizen, (b)onus or (w)eapon.
+  os << "regeneration" << '\n';
+  os << citizens_to_regenerate.size() + bonus_to_regenerate.size() + weapons_to_regenerate.size() << '\n';
+  os << "kind\ttype\tplayer\trounds" << '\n';
+  for (const auto& p : citizens_to_regenerate)
+    os << "c\t" << CitizenType2char(p.first.first) << "\t" << p.first.second << "\t" << p.second << '\n';
+  for (const auto& p : bonus_to_regenerate)
+    os << "b\t" << BonusType2char(p.first) << "\t" << -1 << "\t" << p.second << '\n';
+  for (const auto& p : weapons_to_regenerate)
+    os << "w\t" << WeaponType2char(p.first) << "\t" << -1 << "\t" << p.second << '\n';
+
+  os << '\n';
 }
 
 
-void Board::print_results () const {
+vector<int> Board::winners () const {
   int max_score = 0;
   vector<int> v;
   for (int pl = 0; pl < num_players(); ++pl) {
-
-    cerr << "info: player " <<  name(pl)
-         << " got score "   << score(pl) << endl;
-
     if      (score(pl) == max_score)  v.push_back(pl);
     else if (score(pl) >  max_score) {
       max_score = score(pl);
       v = vector<int>(1, pl);
     }
   }
+  return v;
+}
+
+
+void Board::print_results () const {
+  for (int pl = 0; pl < num_players(); ++pl)
+    cerr << "info: player " <<  name(pl)
+         << " got score "   << score(pl) << '\n';
 
   cerr << "info: player(s)";
-  for (int pl : v) cerr << " " << name(pl);
-  cerr << " got top score" << endl;
+  for (int pl : winners()) cerr << " " << name(pl);
+  cerr << " got top score" << '\n';
 }
 
 // Returns whether c1 wins
 bool Board::first_citizen_wins_attack (const Citizen& c1, const Citizen& c2) {
   int c1_strength = weapon_strength_attack(c1.weapon);
   int c2_strength = weapon_strength_attack(c2.weapon);
-  int M = 1000;
-  int num = random(0,M);
-  double threshold = double(c1_strength)/(c1_strength + c2_strength)*M;
-  return num < threshold;
+  return wins_attack(random(0,ATTACK_M), c1_strength, c2_strength);
 }
 
-void Board::perform_attack (Citizen& ci, Citizen& ci2, set<int>& killed, vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate) {
+void Board::perform_attack (Citizen& ci, Citizen& ci2, vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate) {
+  record(ci2); // ci has been recorded by execute.
   bool first_wins = first_citizen_wins_attack(ci,ci2);
   Citizen& winner = (first_wins ? ci  : ci2);
   Citizen& loser =  (first_wins ? ci2 : ci );
 
   loser.life -= life_lost_in_attack();
   if (loser.life <= 0) { // Dead!!!
-    kill(loser.id,killed);
-    citizens_to_regenerate.push_back({{loser.type,loser.player},num_rounds_regen_citizen(loser.type)});
-    if (loser.type == Builder)  scr[winner.player] += kill_builder_points();
-    else                        scr[winner.player] += kill_warrior_points();
+    CitizenType type = loser.type;
+    int         pl   = loser.player;
+    kill(loser.id);
+    citizens_to_regenerate.push_back({{type,pl},num_rounds_regen_citizen(type)});
+    if (type == Builder)  scr[winner.player] += kill_builder_points();
+    else                  scr[winner.player] += kill_warrior_points();
   }
 }      
 
 bool Board::execute(const Command&    m,
-                    set<int>&         killed,
 		    vector<pair<BonusType,int>>&   bonus_to_regenerate,
 		    vector<pair<WeaponType,int>>&  weapon_to_regenerate,
 		    vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate
@@ -303,14 +394,17 @@ bool Board::execute(const Command&    m,
     return false;
   }
 
-  if (killed.count(id)) return false; // Citizen has been killed in this round
+  // Identifiers are not reused, so a citizen commanded at the start of
+  // the round that is not alive anymore has been killed in this round.
+  if (not citizen_ok(id)) return false;
 
   
   Citizen&      ci = citizens[id];
+  record(ci);
   CitizenType type = ci.type;    
   int           pl = ci.player;
   Pos           op = ci.pos;
-  Cell&         oc = grid[op.i][op.j];
+  Packed_cell&  oc = grid[op.i][op.j];
 
   if (not dir_ok(dir)) {
     //cerr << "warning: invalid dir in command: " << dir << endl;
@@ -325,13 +419,13 @@ bool Board::execute(const Command&    m,
       return false;
     }
 
-    Cell& nc = grid[np.i][np.j];
+    Packed_cell& nc = grid[np.i][np.j];
     if (nc.type == Building) {
       //cerr << "warning: cannot move to position " << np << " with a building." << endl;
       return false;
     }
     else if (nc.bonus == Food) { // Take food and move
-      bonus_to_regenerate.push_back({nc.bonus,num_rounds_regen_food()});
+      bonus_to_regenerate.push_back({Food,num_rounds_regen_food()});
       nc.bonus = NoBonus;
       nc.id = id;
       oc.id = -1;
@@ -339,7 +433,7 @@ bool Board::execute(const Command&    m,
       ci.life = min(ci.life + food_incr_life(), citizen_ini_life(type));
     }
     else if (nc.bonus == Money) { // Take money and move
-      bonus_to_regenerate.push_back({nc.bonus,num_rounds_regen_money()});
+      bonus_to_regenerate.push_back({Money,num_rounds_regen_money()});
       nc.bonus = NoBonus;
       nc.id = id;
       oc.id = -1;
@@ -348,14 +442,14 @@ bool Board::execute(const Command&    m,
     }
     else if (nc.weapon != NoWeapon) {
       if (type == Builder) { // Moves and weapon disappears	
-	weapon_to_regenerate.push_back({nc.weapon,num_rounds_regen_weapon()});
+	weapon_to_regenerate.push_back({WeaponType(nc.weapon),num_rounds_regen_weapon()});
 	nc.weapon = NoWeapon;
 	nc.id = id;
 	oc.id = -1;
 	ci.pos = np;	
       }
       else { // Warrior: moves and takes strongest weapon. Weapon disappears
-	weapon_to_regenerate.push_back({nc.weapon,num_rounds_regen_weapon()});
+	weapon_to_regenerate.push_back({WeaponType(nc.weapon),num_rounds_regen_weapon()});
 	ci.weapon = strongestWeapon(ci.weapon,nc.weapon);
 	nc.weapon = NoWeapon;
 	nc.id = id;
@@ -375,9 +469,9 @@ bool Board::execute(const Command&    m,
       }
       else { // night
 	if (nc.b_owner != pl) { // rival barricade --> demolish independently of whether there is a citizen
-	  nc.resistance -= weapon_strength_demolish(ci.weapon);
+	  nc.resistance = max(nc.resistance - weapon_strength_demolish(ci.weapon), 0);
 	  if (nc.resistance <= 0) { // Barricade disappears
-	    player2barricades[nc.b_owner].erase(np);
+	    sorted_erase(player2barricades[nc.b_owner], np);
 	    nc.resistance = -1;
 	    nc.b_owner = -1;
 	  }	  
@@ -396,7 +490,7 @@ bool Board::execute(const Command&    m,
       if (day) return false;
       else if (citizens[nc.id].player == pl) return false; // Never attack same clan
       else { // Night and other clan: attack but not move!!!!
-	perform_attack(ci,citizens[nc.id],killed,citizens_to_regenerate);
+	perform_attack(ci,citizens[nc.id],citizens_to_regenerate);
       }
     }
     else { // Free cell, move there
@@ -422,7 +516,7 @@ bool Board::execute(const Command&    m,
       return false;
     }
 
-    Cell& nc = grid[np.i][np.j];
+    Packed_cell& nc = grid[np.i][np.j];
     if (nc.type == Building or nc.bonus != NoBonus or nc.weapon != NoWeapon or nc.id != -1) {
       //cerr << "warning: cannot construct in non-empty position " << np << endl;
       return false;
@@ -448,7 +542,7 @@ bool Board::execute(const Command&    m,
     if (nc.resistance == -1) { // new barricade
       nc.resistance = barricade_resistance_step();
       nc.b_owner = pl;
-      player2barricades[pl].insert(np);
+      sorted_insert(player2barricades[pl], np);
     }
     else nc.resistance = min(nc.resistance + barricade_resistance_step(), barricade_max_resistance());
   }
@@ -457,29 +551,26 @@ bool Board::execute(const Command&    m,
 }
 
 
-void Board::kill (int id, set<int>& killed) {
-
-  _my_assert(not killed.count(id), "Already killed");
+void Board::kill (int id) {
 
-  auto it = citizens.find(id);
-  _my_assert(it != citizens.end(), "Could not find citizen to be killed");
+  _my_assert(citizens.count(id), "Could not find citizen to be killed (or already killed).");
 
-  Citizen& ci = it->second;
+  Citizen& ci = citizens[id];
   int      pl = ci.player;
+  record(ci);
 
   grid[ci.pos.i][ci.pos.j].id = -1;
 
   if (ci.type == Builder) {
-    _my_assert(player2builders[pl].count(id), "Builder to kill is not registered.");
-    player2builders[pl].erase(id);
+    _my_assert(sorted_contains(player2builders[pl], id), "Builder to kill is not registered.");
+    sorted_erase(player2builders[pl], id);
   }
   else if (ci.type == Warrior) {
-    _my_assert(player2warriors[pl].count(id),   "Warrior to kill is not registered.");
-    player2warriors[pl].erase(id);
+    _my_assert(sorted_contains(player2warriors[pl], id),   "Warrior to kill is not registered.");
+    sorted_erase(player2warriors[pl], id);
   }
 
-  citizens.erase(it);
-  killed.insert(id);
+  citizens.erase(id);
 }
 
 bool Board::is_good_pos_to_regen ( const Pos& p) const {
@@ -495,15 +586,14 @@ bool Board::is_good_pos_to_regen ( const Pos& p) const {
 }
 
 pair<bool,Pos> Board::get_random_pos_where_regenerate ( ) {
-  vector<Pos> res;
-  for (int i = 0; i < board_rows(); ++i){
-    for (int j = 0; j < board_cols(); ++j) {
-      if (is_good_pos_to_regen(Pos(i,j))) res.push_back(Pos(i,j));
-    }
-  }
-  
-  if (res.size() != 0)  return {true,res[random(0,res.size()-1)]};
-  else                  return {false,Pos()};
+  regen_positions.sync(grid);
+  int num = regen_positions.size();
+  if (num == 0) return {false,Pos()};
+
+  // Same draw as choosing among all the good positions in row-major order.
+  Pos p = regen_positions.nth(random(0,num-1));
+  _my_assert(is_good_pos_to_regen(p), "Regeneration position is not good.");
+  return {true,p};
 }
 
 void Board::regenerate_citizens (vector<pair<pair<CitizenType,int>,int>>& to_regen) {
@@ -564,102 +654,184 @@ void Board::deteriorate_barricades ( ){
 
   // If we are at the last round of night (i.e. next is day), remove them
   if (rnd%num_rounds_per_day() == num_rounds_per_day() - 1) {
-    for (int pl = 0; pl < num_players(); ++pl) player2barricades[pl].clear();
-        
-    for (int i = 0; i < board_rows(); ++i){
-      for (int j = 0; j < board_cols(); ++j) {
-	if (grid[i][j].resistance != -1) {
-	  grid[i][j].resistance = -1;
-	  grid[i][j].b_owner = -1;
-	}
+    for (int pl = 0; pl < num_players(); ++pl) {
+      for (const Pos& p : player2barricades[pl]) {
+	grid[p.i][p.j].resistance = -1;
+	grid[p.i][p.j].b_owner = -1;
       }
+      player2barricades[pl].clear();
     }
   }
   
 }
 
 void Board::next (const vector<Action>& act, ostream& os) {
+  next(act);
+  os << "commands" << '\n';
+  Action::print(commands_done, os);
+}
 
-  _my_assert(ok(), "Invariants are not satisfied.");
 
-  int npl = num_players();
-  _my_assert(int(act.size()) == npl, "Size should be number of players.");
+void Board::next (const vector<Action>& act) {
 
-  // Elements to be regenerated
-  static vector<pair<BonusType,int>> bonus_to_regenerate; // int is rounds to wait
-  static vector<pair<WeaponType,int>> weapons_to_regenerate;
-  static vector<pair<pair<CitizenType,int>,int>> citizens_to_regenerate; // <<citizen,player>,rounds>
+  if (validation == FullValidation) _my_assert(ok(), "Invariants are not satisfied.");
 
-  
-  // Chooses (at most) one command per citizen.
-  set<int> seen;
-  vector<vector<Command>> v(npl);
-  for (int pl = 0; pl < npl; ++pl)
-    for (const Command& m : act[pl].v) {
-      int id     = m.id;
-      int c_type = m.c_type;
-      int dir    = m.dir;
+  grid.forget_changes(); // Players are up to date with the current grid.
+  if (journal) grid.keep_originals(&journal->originals);
 
+  int npl = num_players();
+  _my_assert(int(act.size()) == npl, "Size should be number of players.");
 
-      auto it = citizens.find(id);
 
-      if (it == citizens.end()) {
-        //cerr << "warning: invalid id : " << id << endl;
+  // Keeps the commands of each player for its own citizens. There is
+  // at most one per citizen, as Action::execute already discards the rest.
+  pending.resize(npl);
+  for (int pl = 0; pl < npl; ++pl) {
+    pending[pl].clear();
+    for (const Command& m : act[pl].v) {
+      if (not citizen_ok(m.id)) {
+        //cerr << "warning: invalid id : " << m.id << endl;
       }
-
-      else if (it->second.player != pl) {
-        //cerr << "warning: citizen " << id << " of player " << it->second.player
+      else if (citizens[m.id].player != pl) {
+        //cerr << "warning: citizen " << m.id << " of player " << citizens[m.id].player
 	//   << " not owned by " << pl << endl;
       }
-      else {
-        // Here an assert as repetitions should have already been filtered out.
-        _my_assert(not seen.count(id), "More than one command for the same citizen.");
-        seen.insert(id);
-
-        v[pl].push_back(Command(id, c_type, dir));
-      }
+      else pending[pl].push_back(m);
     }
+  }
 
 
   // Makes all players' commands using a random order,
   // but respecting the relative order of the citizens of the same player.
   // Permutations are not equally likely to avoid favoring leading clans.
+  // Each time, the ran-th of the players with some command pending is
+  // chosen: they are kept in increasing order in active.
   int num = 0; // Counts number of pending commands
-  for (int pl = 0; pl < npl; ++pl) num += v[pl].size();
+  active.clear();
+  cursor.assign(npl, 0);
+  for (int pl = 0; pl < npl; ++pl) {
+    num += pending[pl].size();
+    if (not pending[pl].empty()) active.push_back(pl);
+  }
 
-  set<int> killed;
-  vector<Command> commands_done;
-  vector<int> index(npl, 0);
+  commands_done.clear();
   while (num--) {
-    int q = 0; // Counts number of players with some action pending
-    for (int pl = 0; pl < npl; ++pl) q += index[pl] < (int)v[pl].size();
+    int q = active.size(); // Number of players with some action pending
     _my_assert(q > 0, "q > 0 in next.");
-    int ran = random(1,q); // Decide whether 1st, 2nd, 3rd,, player with something pending is chosen
-    int pl = -1;
-    int acum = 0;
-    while (acum < ran) {
-      ++pl;
-      acum += index[pl] < (int)v[pl].size(); // If index > ..., then player has nothing pending
-                                             // and does not count
-    }
+    int k  = random(1,q) - 1;
+    int pl = active[k];
 
-    const Command& m = v[pl][index[pl]++];
-    if (execute(m, killed, bonus_to_regenerate, weapons_to_regenerate, citizens_to_regenerate))
-      commands_done.push_back(m);
+    const Command& m = pending[pl][cursor[pl]++];
+    if (cursor[pl] == (int)pending[pl].size()) active.erase(active.begin() + k);
 
+    if (execute(m, bonus_to_regenerate, weapons_to_regenerate, citizens_to_regenerate))
+      commands_done.push_back(m);
   }
-  os << "commands" << endl;
-  Action::print(commands_done, os);
 
   regenerate_citizens(citizens_to_regenerate);  
   regenerate_bonus(bonus_to_regenerate);
   regenerate_weapons(weapons_to_regenerate);
   deteriorate_barricades();
+
+  // Between rounds, regen_positions is always up to date with the grid,
+  // so that copies of the board (whose grid forgets its changes) are too.
+  regen_positions.sync(grid);
   
   ++rnd;
   day = (rnd%(num_rounds_per_day()) < num_rounds_per_day()/2);
 
-  _my_assert(ok(), "Invariants are not satisfied.");
+  if (validation == FullValidation) {
+    _my_assert(ok(), "Invariants are not satisfied.");
+  }
+  else if (validation == IncrementalValidation) {
+    // Every cell written in this round is in grid.changes(), including the
+    // cells of attacked citizens, so only the citizens that moved are left.
+    vector<int> ids;
+    for (const Command& m : commands_done) ids.push_back(m.id);
+    _my_assert(ok(grid.changes(), ids), "Invariants are not satisfied.");
+  }
+
+  if (journal) {
+    journal->cells = grid.changes();
+    grid.keep_originals(0);
+  }
+}
+
+
+void Board::record (const Citizen& ci) {
+  if (journal) journal->citizens.push_back(ci);
+}
+
+
+void Board::next (const vector<Action>& act, Journal& j) {
+  j.cells    .clear();
+  j.originals.clear();
+  j.citizens .clear();
+  j.scr                    = scr;
+  j.rnd                    = rnd;
+  j.day                    = day;
+  j.rnd_seed               = rnd_seed;
+  j.fresh_id               = fresh_id;
+  j.bonus_to_regenerate    = bonus_to_regenerate;
+  j.weapons_to_regenerate  = weapons_to_regenerate;
+  j.citizens_to_regenerate = citizens_to_regenerate;
+
+  journal = &j;
+  regen_positions.keep_log(&j.regen_log);
+  next(act);
+  regen_positions.keep_log(0);
+  journal = 0;
+}
+
+
+void Board::undo (const Journal& j) {
+
+  // Builders or warriors of the player of ci, as ci's type.
+  auto list_of = [this](const Citizen& ci) -> vector<int>& {
+    return ci.type == Builder ? player2builders[ci.player] : player2warriors[ci.player];
+  };
+
+  // Citizens created in the round: they are the only ones with newer identifiers.
+  for (int id = j.fresh_id; id < fresh_id; ++id)
+    if (citizens.count(id)) {
+      sorted_erase(list_of(citizens[id]), id);
+      citizens.erase(id);
+    }
+
+  // Citizens changed or killed in the round, from the last change back.
+  for (int k = int(j.citizens.size()) - 1; k >= 0; --k) {
+    const Citizen& ci = j.citizens[k];
+    if (citizens.count(ci.id)) citizens[ci.id] = ci;
+    else {
+      citizens.insert(ci);
+      sorted_insert(list_of(ci), ci.id);
+    }
+  }
+
+  // Cells, with the barricades whose owner changed.
+  int cols = grid.cols();
+  for (int c = 0; c < (int)j.cells.size(); ++c) {
+    Pos p(j.cells[c] / cols, j.cells[c] % cols);
+    Packed_cell&       cell = grid[p.i][p.j];
+    const Packed_cell& orig = j.originals[c];
+    if (cell.b_owner != orig.b_owner) {
+      if (cell.b_owner != -1) sorted_erase (player2barricades[cell.b_owner], p);
+      if (orig.b_owner != -1) sorted_insert(player2barricades[orig.b_owner], p);
+    }
+    cell = orig;
+  }
+
+  scr                    = j.scr;
+  rnd                    = j.rnd;
+  day                    = j.day;
+  rnd_seed               = j.rnd_seed;
+  fresh_id               = j.fresh_id;
+  bonus_to_regenerate    = j.bonus_to_regenerate;
+  weapons_to_regenerate  = j.weapons_to_regenerate;
+  citizens_to_regenerate = j.citizens_to_regenerate;
+  regen_positions.undo(j.regen_log);
+
+  if (validation == FullValidation) _my_assert(ok(), "Invariants are not satisfied.");
 }
 
 
@@ -669,13 +841,13 @@ void Board::next (const vector<Action>& act, ostream& os) {
 
 int Board::generate_street (int s_id, int length) {
   int filled = 0;
-  vector<Dir> dirs = {Up, Down, Left, Right};
-  Dir last_dir = dirs[random(0,dirs.size()-1)];
+  Dir dirs[4] = {Up, Down, Left, Right};
+  Dir last_dir = dirs[random(0,3)];
   Pos p = get_ok_pos_for_initial_street();
   street_plan[p.i][p.j] = s_id;
   ++filled;
   while (length > 0) {
-    random_shuffle(dirs.begin(),dirs.end());
+    random_shuffle(dirs,dirs + 4);
     Dir new_possible_dir = Up; // Explore the possibility of turning
     bool dir_found = false;
     for (auto& d:dirs) {
@@ -708,7 +880,7 @@ int Board::generate_street (int s_id, int length) {
 }
 
 void Board::generate_buildings (int num_building_cells, int num_streets){
-  street_plan = vector<vector<int>>(board_rows(),vector<int>(board_cols(),0));
+  street_plan.assign(board_rows(),vector<int>(board_cols(),0)); // Reuses the memory of previous attempts.
   
   int num_streets_pending = num_streets;
   while (num_streets_pending > 0) {
@@ -763,15 +935,14 @@ bool Board::pos_ok_for_street(int s_id, const Pos& p){
   if (j == board_cols() -1) return false;
 
   int num_occupied = 0;
-  vector<Dir> dirs = {Up, Down, Left, Right};
-  for (auto& d: dirs) {
+  for (Dir d : {Up, Down, Left, Right}) {
     Pos newPos = p + d; // Will exists because p is not on a border
     int ni = newPos.i, nj = newPos.j;
     if (street_plan[ni][nj] != 0 and street_plan[ni][nj] != s_id) return false;
     else if (street_plan[ni][nj] == s_id) ++num_occupied;
   }
 
-  vector<pair<int,int>> diags = {{1,1},{1,-1},{-1,1},{-1,-1}};
+  static const pair<int,int> diags[4] = {{1,1},{1,-1},{-1,1},{-1,-1}};
   for (auto& d : diags) {
     Pos newPos = Pos(p.i + d.first, p.j + d.second);
     int ni = newPos.i, nj = newPos.j;
@@ -792,14 +963,13 @@ bool Board::pos_ok_for_initial_street(const Pos& p){
   if (j == board_cols() -1) return false;
 
   int num_occupied = 0;
-  vector<Dir> dirs = {Up, Down, Left, Right};
-  for (auto& d: dirs) {
+  for (Dir d : {Up, Down, Left, Right}) {
     Pos newPos = p + d; // Will exists because p is not on a border
     int n_i = newPos.i, n_j = newPos.j;
     if (street_plan[n_i][n_j] != 0) return false;
   }
 
-  vector<pair<int,int>> diags = {{1,1},{1,-1},{-1,1},{-1,-1}};
+  static const pair<int,int> diags[4] = {{1,1},{1,-1},{-1,1},{-1,-1}};
   for (auto& d : diags) {
     Pos newPos = Pos(p.i + d.first, p.j + d.second);
     int n_i = newPos.i, n_j = newPos.j;
@@ -809,49 +979,64 @@ bool Board::pos_ok_for_initial_street(const Pos& p){
   return true;
 }
 
-void Board::explore_from(vector<vector<int>>& G, int i, int j, int n) {
-  G[i][j] = n;
-  for (auto& d:{Up,Down,Left,Right}) {
-    Pos np = Pos(i,j) + d;
-    if (pos_ok(np) and G[np.i][np.j] == -1) explore_from(G,np.i,np.j,n);
-  }
-}
-
 int Board::num_connected_components( ){
-  vector<vector<int>> G(board_rows(),vector<int>(board_cols(),-1));
-
-  for (int i = 0; i < board_rows(); ++i) {
-    for (int j = 0; j < board_cols(); ++j){
-      if (grid[i][j].type == Building) G[i][j] = -2;
+  int rows = board_rows();
+  int cols = board_cols();
+  const Grid& g = grid; // Only reads: no changes are recorded.
+
+  // -2 for buildings, -1 for cells not reached yet. Iterative flood fill
+  // from each cell not reached yet, so that the depth is not a problem.
+  component.assign(rows*cols, -1);
+  for (int k = 0; k < rows*cols; ++k)
+    if (g[k / cols][k % cols].type == Building) component[k] = -2;
+
+  auto reach = [&](int k, int n) {
+    if (component[k] == -1) {
+      component[k] = n;
+      to_explore.push_back(k);
     }
-  }
-
-  int n = 0;    
-  for (int i = 0; i < board_rows(); ++i) {
-    for (int j = 0; j < board_cols(); ++j){
-      if (G[i][j] == -1) {
-	explore_from(G,i,j,n);
-	++n;
-      }
+  };
+
+  int n = 0;
+  for (int k = 0; k < rows*cols; ++k) {
+    if (component[k] != -1) continue;
+    reach(k, n);
+    while (not to_explore.empty()) {
+      int c = to_explore.back();
+      to_explore.pop_back();
+      int i = c / cols, j = c % cols;
+      if (i > 0)        reach(c - cols, n);
+      if (i < rows - 1) reach(c + cols, n);
+      if (j > 0)        reach(c - 1,    n);
+      if (j < cols - 1) reach(c + 1,    n);
     }
+    ++n;
   }
 
   return n;
 }
 
-void Board::generate_random_board ( ){
+// generate_street shuffles with random_shuffle, which draws from the global rand().
+// Boards generated within the same process (e.g. by the Runner) take turns here and
+// restart rand(), so each one is the board a fresh Game process gives for its seed.
+static mutex generation_mutex;
+
+void Board::generate_random_board (int percent, int num_streets){
+  lock_guard<mutex> lock(generation_mutex);
+  srand(1);
+
   int rows = board_rows();
   int cols = board_cols();
 
   
   // Generate buildings (leaving space for citizens)
-  static const int num_building_cells = 0.20*rows*cols; // 20% buildings
-  static const int num_streets = 5;
+  const int num_building_cells = percent/100.0*rows*cols; // 20% buildings by default
     
   do {
     // Create grid
-    grid = vector<vector<Cell>>(rows, vector<Cell>(cols));
+    grid = Grid(rows, cols);
     generate_buildings(num_building_cells, num_streets);
+    ++generation_attempts;
   } while (num_connected_components() != 1);
 
   
@@ -893,3 +1078,172 @@ void Board::generate_random_board ( ){
 
   
 }
+
+
+/**
+ * Set of cells, by row-major index, with constant time insertion,
+ * removal and choice of the k-th one (in no particular order).
+ */
+class Cell_set {
+
+public:
+
+  Cell_set (int num_cells) : where(num_cells, -1) { }
+
+  int  size     ()      const { return cells.size(); }
+  bool contains (int k) const { return where[k] != -1; }
+  int  operator[] (int x) const { return cells[x]; }
+
+  void insert (int k) {
+    if (contains(k)) return;
+    where[k] = cells.size();
+    cells.push_back(k);
+  }
+
+  void erase (int k) {
+    if (not contains(k)) return;
+    int last = cells.back();
+    cells[where[k]] = last;
+    where[last] = where[k];
+    cells.pop_back();
+    where[k] = -1;
+  }
+
+private:
+
+  vector<int> cells;
+  vector<int> where; // Position of each cell in cells, or -1.
+};
+
+
+void Board::generate_fast_random_board (int percent, int num_streets){
+  int rows = board_rows();
+  int cols = board_cols();
+  int n    = rows*cols;
+
+  // As generate_random_board.
+  int num_building_cells = percent/100.0*rows*cols;
+
+  grid = Grid(rows, cols);
+  generation_attempts = 1;
+
+  // Neighbours of a cell, in order around it, so that consecutive ones
+  // (also the last and the first) are adjacent.
+  const int di[8] = {-1, -1, -1,  0,  1,  1,  1,  0};
+  const int dj[8] = {-1,  0,  1,  1,  1,  0, -1, -1};
+  const Dir dirs[4] = {Up, Down, Left, Right};
+
+  auto interior = [&](int i, int j) {
+    return i > 0 and i < rows - 1 and j > 0 and j < cols - 1;
+  };
+
+  // Street of each cell (0 if none), and number of street cells in the
+  // 3x3 square centered at each cell. The interior cells with none can
+  // start a street (as in pos_ok_for_initial_street).
+  vector<int> plan(n, 0);
+  vector<int> near(n, 0);
+  Cell_set    starts(n);
+  for (int i = 1; i < rows - 1; ++i)
+    for (int j = 1; j < cols - 1; ++j) starts.insert(i*cols + j);
+
+  auto place = [&](int i, int j, int s_id) {
+    plan[i*cols + j] = s_id;
+    for (int ii = i - 1; ii <= i + 1; ++ii)
+      for (int jj = j - 1; jj <= j + 1; ++jj)
+        if (++near[ii*cols + jj] == 1) starts.erase(ii*cols + jj);
+  };
+
+  // As pos_ok_for_street, but neither can the street close a loop: its cells
+  // around (i, j), at most two, must be adjacent. Other streets are never around,
+  // so the cells of each street are a component on their own, and a loop is the
+  // only way the cells that are not buildings can get disconnected.
+  auto ok_for_street = [&](int s_id, int i, int j) {
+    if (not interior(i, j) or plan[i*cols + j] != 0) return false;
+    int num = 0, first = -1, second = -1;
+    for (int k = 0; k < 8; ++k) {
+      int s = plan[(i + di[k])*cols + j + dj[k]];
+      if (s == 0) continue;
+      if (s != s_id or ++num > 2) return false;
+      if (first == -1) first  = k;
+      else             second = k;
+    }
+    return num < 2 or (abs(di[first] - di[second]) <= 1 and abs(dj[first] - dj[second]) <= 1);
+  };
+
+  // As generate_street.
+  auto generate_street = [&](int s_id, int length) {
+    if (starts.size() == 0) return 0;
+    int filled = 0;
+    Dir last_dir = dirs[random(0, 3)];
+    int start = starts[random(0, starts.size() - 1)];
+    Pos p(start / cols, start % cols);
+    place(p.i, p.j, s_id);
+    ++filled;
+    while (length > 0) {
+      int order[4] = {0, 1, 2, 3};
+      for (int k = 3; k > 0; --k) swap(order[k], order[random(0, k)]);
+      bool dir_found = false;
+      Dir  new_dir   = Up;
+      for (int k = 0; k < 4 and not dir_found; ++k) {
+        Pos np = p + dirs[order[k]];
+        if (ok_for_street(s_id, np.i, np.j)) {
+          new_dir   = dirs[order[k]];
+          dir_found = true;
+        }
+      }
+
+      Pos np = p + last_dir;
+      if (random(1,8) != 1 and ok_for_street(s_id, np.i, np.j)) p = np; // Continue same direction
+      else if (dir_found) {                                             // Turn
+        last_dir = new_dir;
+        p += new_dir;
+      }
+      else return filled;                                               // Stop
+      place(p.i, p.j, s_id);
+      --length;
+      ++filled;
+    }
+    return filled;
+  };
+
+  for (int s_id = num_streets; s_id > 0; --s_id) {
+    int length = s_id != 1 ? num_building_cells/s_id : num_building_cells;
+    num_building_cells -= generate_street(s_id, length);
+  }
+
+  // The empty cells, to place everything else in them.
+  Cell_set empty(n);
+  for (int k = 0; k < n; ++k) {
+    if (plan[k] != 0) grid[k / cols][k % cols].type = Building;
+    else              empty.insert(k);
+  }
+
+  auto take_empty = [&]() {
+    _my_assert(empty.size() > 0, "No empty cell left in the generated board.");
+    int k = empty[random(0, empty.size() - 1)];
+    empty.erase(k);
+    return Pos(k / cols, k % cols);
+  };
+
+  // Citizens, bonus and weapons, as generate_random_board.
+  for (int pl = 0; pl < num_players(); ++pl) {
+    for (int i = 0; i < num_ini_builders(); ++i) create_new_citizen(take_empty(), Builder, pl);
+    for (int i = 0; i < num_ini_warriors(); ++i) create_new_citizen(take_empty(), Warrior, pl);
+  }
+  for (int i = 0; i < num_ini_food(); ++i) {
+    Pos p = take_empty();
+    grid[p.i][p.j].bonus = Food;
+  }
+  for (int i = 0; i < num_ini_money(); ++i) {
+    Pos p = take_empty();
+    grid[p.i][p.j].bonus = Money;
+  }
+  for (int i = 0; i < num_ini_guns(); ++i) {
+    Pos p = take_empty();
+    grid[p.i][p.j].weapon = Gun;
+  }
+  for (int i = 0; i < num_ini_bazookas(); ++i) {
+    Pos p = take_empty();
+    grid[p.i][p.j].weapon = Bazooka;
+  }
+}
@@ -7,6 +7,7 @@
 #include "Info.hh"
 #include "Action.hh"
 #include "Random.hh"
+#include "Regen_positions.hh"
 
 
 /**
@@ -22,9 +23,66 @@ class Board : public Info, public Random_generator {
 
   friend class Game;
   friend class SecGame;
+  friend class Replay;
+
+public:
+
+  /**
+   * How next() checks the invariants of the board: not at all, only
+   * the cells and citizens changed in the round, or the whole board
+   * before and after the round (slow, for debugging).
+   */
+  enum Validation { NoValidation, IncrementalValidation, FullValidation };
+
+#ifdef FULL_VALIDATION
+  static const Validation default_validation = FullValidation;
+#else
+  static const Validation default_validation = IncrementalValidation;
+#endif
+
+  /**
+   * An attack draws a number in [0..ATTACK_M].
+   */
+  static const int ATTACK_M = 1000;
+
+  /**
+   * Whether a citizen with strength s1 wins an attack against one with strength s2
+   * when num is drawn, i.e. whether num < s1/(s1 + s2)*ATTACK_M. In integers, so that
+   * it is exact and the same with any compiler and flags (e.g. -ffast-math).
+   * bench attack checks that it is the same as the former computation with doubles.
+   */
+  static bool wins_attack (int num, int s1, int s2) {
+    return (long long)num*((long long)s1 + s2) < (long long)s1*ATTACK_M;
+  }
+
+private:
 
   vector<string> names;
   int            fresh_id;
+  Validation     validation;
+
+  // Elements to be regenerated
+  vector<pair<BonusType,int>>              bonus_to_regenerate;    // int is rounds to wait
+  vector<pair<WeaponType,int>>             weapons_to_regenerate;
+  vector<pair<pair<CitizenType,int>,int>>  citizens_to_regenerate; // <<citizen,player>,rounds>
+
+  // Where elements can be regenerated
+  Regen_positions regen_positions;
+
+  // Commands performed in the last round
+  vector<Command> commands_done;
+
+  // Scheduling of the commands in next(), kept to reuse their memory:
+  // the valid commands of each player, how many of them have been
+  // scheduled, and the players with some command still pending.
+  vector<vector<Command>> pending;
+  vector<int>             cursor;
+  vector<int>             active;
+
+  /**
+   * Empty board, to be filled by a Replay.
+   */
+  Board () : fresh_id(0), validation(default_validation), generation_attempts(0), journal(0) { }
 
   /**
    * Checks whether initial fixed board is ok
@@ -33,17 +91,10 @@ class Board : public Info, public Random_generator {
   
   /**
    * Reads the generator method, and generates or reads the grid.
+   * RANDOM and FAST can be followed, in the same line, by the percentage
+   * of building cells and the number of streets (20 and 5 by default).
    */
-  void read_generator_and_grid (istream& is) {
-    string generator;
-    is >> generator;
-    if (generator == "FIXED") {
-      read_grid(is);
-      check_is_good_initial_fixed_board();
-    }
-    else if (generator == "RANDOM") generate_random_board();
-    else                            _my_assert(false,"unknown generator  " + generator);
-  }
+  void read_generator_and_grid (istream& is);
 
   /**
    * Prints some information of the citizen.
@@ -56,7 +107,7 @@ class Board : public Info, public Random_generator {
        << ci.pos.j                   << '\t'        
        << WeaponType2char(ci.weapon) << '\t'
        << ci.life                    << '\t'      
-       << endl;
+       << '\n';
   }
 
   /**
@@ -68,15 +119,14 @@ class Board : public Info, public Random_generator {
    * Tries to apply a move. Returns true if it could.
    */
   bool execute(const Command&    m,
-		      set<int>&         killed,
 		      vector<pair<BonusType,int>>&   bonus_to_regenerate,
 		      vector<pair<WeaponType,int>>&  weapon_to_regenerate,
 		      vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate
 		      );
   /**
-   * Kill citizen with id, and add it to killed
+   * Kill citizen with id
    */
-  void kill(int id, set<int>& killed);
+  void kill(int id);
 
   /*
    * Returns whether citizen c1 wins c2 in an attack
@@ -84,9 +134,9 @@ class Board : public Info, public Random_generator {
   bool first_citizen_wins_attack(const Citizen& c1, const Citizen& c2);
 
   /* 
-   * Perfom an attack beween c1 and c2 and updates killed and citizens_to_regenerate (if some of them dies)
+   * Perfom an attack beween c1 and c2 and updates citizens_to_regenerate (if some of them dies)
    */
-  void perform_attack (Citizen& c1, Citizen& c2, set<int>& killed, vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate);
+  void perform_attack (Citizen& c1, Citizen& c2, vector<pair<pair<CitizenType,int>,int>>& citizens_to_regenerate);
 
   /*
    * Regenerates the citizens in to_regen. Type is {{CitizenType,Player},Rounds}
@@ -125,9 +175,9 @@ class Board : public Info, public Random_generator {
 
 
   /**
-   * Generates a board.
+   * Generates a board with about percent% of building cells in num_streets streets.
    */
-  void generate_random_board ( );
+  void generate_random_board (int percent, int num_streets);
   
   /**
    * Randomnly returns an empty pos
@@ -174,14 +224,25 @@ class Board : public Info, public Random_generator {
    */
   int num_connected_components( );
 
-  /** 
-   * Auxiliary DFS to count connected components
-   */
-  void explore_from(vector<vector<int>>& G, int i, int j, int n);
-
   // Grid that stores the already generated streets. 0 means no street. Otherwise, contains street_ids
   vector<vector<int>> street_plan;
 
+  // Component of each cell, by row-major index, and cells left to explore,
+  // for num_connected_components. Kept to reuse their memory from one call to the next.
+  vector<int> component;
+  vector<int> to_explore;
+
+  // Number of grids the generator made until one was connected.
+  int generation_attempts;
+
+  /**
+   * Generates a board like generate_random_board, but without retries and
+   * with the random generator of the board only (another board for each seed).
+   * The candidate positions are kept up to date as streets grow, and a
+   * street never closes a loop, so the streets are connected by construction.
+   */
+  void generate_fast_random_board (int percent, int num_streets);
+
 
   /////////////////////// END BOARD GENERATION ///////////////////////  
   
@@ -192,6 +253,21 @@ public:
    */
   Board (istream& is, int seed);
 
+  /**
+   * Returns how many grids the generator made until one was connected:
+   * 1 for the FAST generator, and 0 for a FIXED board.
+   */
+  inline int num_generation_attempts () const {
+    return generation_attempts;
+  }
+
+  /**
+   * Sets how next() checks the invariants (default_validation by default).
+   */
+  inline void set_validation (Validation v) {
+    validation = v;
+  }
+
   /**
    * Returns the name of a player.
    */
@@ -213,7 +289,12 @@ public:
   /**
    * Prints the state of the board to a stream.
    */
-  void print_state (ostream& os);
+  void print_state (ostream& os) const;
+
+  /**
+   * Returns the players that have the top score, in increasing order.
+   */
+  vector<int> winners () const;
 
   /**
    * Prints the results and the names of the winning players.
@@ -226,6 +307,96 @@ public:
    */
   void next (const vector<Action>& act, ostream& os);
 
+  /**
+   * Same, without printing anything.
+   */
+  void next (const vector<Action>& act);
+
+  /**
+   * Board with the settings and state of info, so that a player can
+   * simulate rounds with next() (include Board.hh from the AI).
+   * Its random generator starts from seed, and it has no pending
+   * regenerations, since players do not know them.
+   */
+  Board (const Info& info, int seed);
+
+  /**
+   * Everything that next() changes: the state, the random generator,
+   * the pending regenerations and the next identifier of a citizen.
+   * All of it is kept in flat vectors, so saving to or restoring from
+   * a snapshot that is reused copies memory without allocating.
+   */
+  class Snapshot {
+
+    friend class Board;
+
+    State                                    state;
+    long long                                rnd_seed;
+    int                                      fresh_id;
+    vector<pair<BonusType,int>>              bonus_to_regenerate;
+    vector<pair<WeaponType,int>>             weapons_to_regenerate;
+    vector<pair<pair<CitizenType,int>,int>>  citizens_to_regenerate;
+    Regen_positions                          regen_positions;
+  };
+
+  /**
+   * Saves the current board to s.
+   */
+  void save (Snapshot& s) const;
+
+  /**
+   * Makes the board as it was when saved to s.
+   */
+  void restore (const Snapshot& s);
+
+  /**
+   * What a round changed, to undo it: the cells and citizens it changed,
+   * as they were before, and the rest of what next() changes (as in a
+   * Snapshot, except for the grid, the citizens and their lists, which
+   * undo recomputes from the changed cells and citizens).
+   * Undoing takes time proportional to what the round changed.
+   * A journal that is reused does not allocate.
+   */
+  class Journal {
+
+    friend class Board;
+
+    vector<int>                              cells;     // Changed cells, by row-major index ...
+    vector<Packed_cell>                      originals; // ... and their values before the round.
+    vector<Citizen>                          citizens;  // Citizens before each change, in order.
+    vector<int>                              scr;
+    int                                      rnd;
+    bool                                     day;
+    long long                                rnd_seed;
+    int                                      fresh_id;
+    vector<pair<BonusType,int>>              bonus_to_regenerate;
+    vector<pair<WeaponType,int>>             weapons_to_regenerate;
+    vector<pair<pair<CitizenType,int>,int>>  citizens_to_regenerate;
+    Regen_positions::Log                     regen_log;
+  };
+
+  /**
+   * Same as next(act), also recording in j how to undo the round.
+   */
+  void next (const vector<Action>& act, Journal& j);
+
+  /**
+   * Undoes the round recorded in j, which must be the last round applied
+   * and not undone yet. Rounds can be undone one after the other, from
+   * the last one. The commands done in the last round are not restored.
+   */
+  void undo (const Journal& j);
+
+private:
+
+  // Where next() records how to undo the round, or null.
+  Journal* journal;
+
+  /**
+   * Records the citizen before it is changed, if there is a journal.
+   */
+  void record (const Citizen& ci);
+
 };
 
 #endif
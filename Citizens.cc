@@ -0,0 +1,3 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Citizens.hh"
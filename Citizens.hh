@@ -0,0 +1,152 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Citizens_hh
+#define Citizens_hh
+
+
+#include "Structs.hh"
+
+
+/**
+ * Contains the Citizens class, the storage of the citizens of a State.
+ */
+
+
+/**
+ * Set of citizens indexed by identifier.
+ * Identifiers are small and never reused (see Board::fresh_id), so
+ * slot id of a vector holds the citizen with identifier id, if alive.
+ * Iteration visits the alive citizens in increasing order of identifier.
+ */
+class Citizens {
+
+public:
+
+  class const_iterator;
+
+  Citizens ();
+
+  /**
+   * Returns the number of alive citizens.
+   */
+  int size () const;
+
+  /**
+   * Returns whether there is an alive citizen with identifier id.
+   */
+  bool count (int id) const;
+
+  /**
+   * Returns the citizen with identifier id, which must be alive.
+   */
+  Citizen&       operator[] (int id);
+  const Citizen& operator[] (int id) const;
+
+  /**
+   * Adds c, whose identifier must not be alive.
+   */
+  void insert (const Citizen& c);
+
+  /**
+   * Removes the citizen with identifier id, which must be alive.
+   * References to the other citizens remain valid until the next insert.
+   */
+  void erase (int id);
+
+  void clear ();
+
+  const_iterator begin () const;
+  const_iterator end   () const;
+
+private:
+
+  vector<Citizen> slots; // slots[id].id == id iff citizen id is alive.
+  int             num;   // Number of alive citizens.
+};
+
+
+/**
+ * Forward iterator over the alive citizens.
+ */
+class Citizens::const_iterator {
+
+public:
+
+  const Citizen& operator*  () const { return *p; }
+  const Citizen* operator-> () const { return  p; }
+
+  const_iterator& operator++ () {
+    ++p;
+    skip();
+    return *this;
+  }
+
+  bool operator== (const const_iterator& o) const { return p == o.p; }
+  bool operator!= (const const_iterator& o) const { return p != o.p; }
+
+private:
+
+  friend class Citizens;
+
+  const Citizen* p;
+  const Citizen* first;
+  const Citizen* last;
+
+  const_iterator (const Citizen* first, const Citizen* p, const Citizen* last) :
+    p(p), first(first), last(last) {
+    skip();
+  }
+
+  // Advances p to the next alive citizen (or to last).
+  void skip () {
+    while (p != last and p->id != p - first) ++p;
+  }
+};
+
+
+inline Citizens::Citizens () : num(0) { }
+
+inline int Citizens::size () const {
+  return num;
+}
+
+inline bool Citizens::count (int id) const {
+  return id >= 0 and id < (int)slots.size() and slots[id].id == id;
+}
+
+inline Citizen& Citizens::operator[] (int id) {
+  return slots[id];
+}
+
+inline const Citizen& Citizens::operator[] (int id) const {
+  return slots[id];
+}
+
+inline void Citizens::insert (const Citizen& c) {
+  _my_assert(c.id >= 0 and not count(c.id), "Citizen identifier already in use.");
+  if (c.id >= (int)slots.size()) slots.resize(c.id + 1);
+  slots[c.id] = c;
+  ++num;
+}
+
+inline void Citizens::erase (int id) {
+  _my_assert(count(id), "Citizen identifier not in use.");
+  slots[id].id = -1;
+  --num;
+}
+
+inline void Citizens::clear () {
+  slots.clear();
+  num = 0;
+}
+
+inline Citizens::const_iterator Citizens::begin () const {
+  return const_iterator(slots.data(), slots.data(), slots.data() + slots.size());
+}
+
+inline Citizens::const_iterator Citizens::end () const {
+  return const_iterator(slots.data(), slots.data() + slots.size(), slots.data() + slots.size());
+}
+
+
+#endif
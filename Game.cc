@@ -3,12 +3,17 @@
 #include "Game.hh"
 
 
-void Game::run (vector<string> names, istream& is, ostream& os, int seed) {
-  cerr << "info: seed " << seed << endl;
+void Game::run (vector<string> names, istream& is, ostream& os, int seed,
+                const Options& opt) {
+  // Progress messages, unless quiet.
+  ostream log(opt.quiet ? 0 : cerr.rdbuf());
 
-  cerr << "info: loading game" << endl;
+  log << "info: seed " << seed << endl;
+
+  log << "info: loading game" << endl;
   Board b(is, seed);
-  cerr << "info: loaded game" << endl;
+  b.set_validation(opt.validation);
+  log << "info: loaded game" << endl;
 
   int np = b.num_players();
   int nr = b.num_rounds();
@@ -19,37 +24,148 @@ void Game::run (vector<string> names, istream& is, ostream& os, int seed) {
   for (int pl = 0; pl < np; ++pl) {
     string name = names[pl];
     b.names[pl] = name;
-    cerr << "info: loading player " << name << endl;
+    log << "info: loading player " << name << endl;
     players.push_back(Registry::new_player(name));
     players[pl]->me_ = pl;
     players[pl]->set_random_seed(seed + pl + 1);
     *static_cast<Settings*>(players[pl]) = (Settings)b;
   }
-  cerr << "info: players loaded" << endl;
+  log << "info: players loaded" << endl;
+
+  // The text of each round is built here and then written to os at once,
+  // so that os sees a single write per round instead of one per line.
+  ostringstream text;
 
-  os << "Game" << endl << endl;
-  os << "Seed " << seed << endl << endl;
-  b.print_settings(os);
-  b.print_names(os);
-  b.print_state(os);
+  Replay* replay = 0;
+  if (opt.binary) replay = new Replay(os, b, seed);
+  else {
+    text << "Game" << '\n' << '\n';
+    text << "Seed " << seed << '\n' << '\n';
+    b.print_settings(text);
+    b.print_names(text);
+    b.print_state(text);
+    os << text.str();
+  }
 
+  Play_clock     clock(np);
+  vector<Action> actions(np); // Reused from round to round.
   for (int round = 0; round < nr; ++round) {
-    cerr << "info: start round " << round << endl;
-    vector<Action> actions(np);
-    for (int pl = 0; pl < np; ++pl) {
-      cerr << "info:     start player " << pl << endl;
-      players[pl]->reset(b);
-      players[pl]->play();
-      actions[pl] = *players[pl];
-      cerr << "info:     end player " << pl << endl;
-    }
+    log << "info: start round " << round << endl;
+    play_round(b, players, actions, clock, opt, log);
 
-    b.next(actions, os);
-    b.print_state(os);
-    cerr << "info: end round " << round << endl;
+    if (opt.binary) {
+      b.next(actions);
+      replay->add_round(b);
+    }
+    else {
+      text.str("");
+      b.next(actions, text);
+      b.print_state(text);
+      os << text.str();
+    }
+    log << "info: end round " << round << endl;
   }
+  delete replay;
+  os.flush();
 
   b.print_results();
+  clock.print(cerr, b.names);
+
+  log << "info: game played" << endl;
+}
+
+
+Game::Result Game::play (const vector<string>& names, istream& is, int seed,
+                         const Options& opt) {
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  Board b(is, seed);
+  b.set_validation(opt.validation);
+
+  int np = b.num_players();
+  int nr = b.num_rounds();
+
+  _my_assert(np == (int)names.size(), "Wrong number of players.");
+
+  vector<Player*> players;
+  for (int pl = 0; pl < np; ++pl) {
+    b.names[pl] = names[pl];
+    players.push_back(Registry::new_player(names[pl]));
+    players[pl]->me_ = pl;
+    players[pl]->set_random_seed(seed + pl + 1);
+    *static_cast<Settings*>(players[pl]) = (Settings)b;
+  }
+
+  Play_clock     clock(np);
+  ostream        log(0);      // Nothing is logged.
+  vector<Action> actions(np); // Reused from round to round.
+  for (int round = 0; round < nr; ++round) {
+    play_round(b, players, actions, clock, opt, log);
+    b.next(actions);
+  }
+
+  for (Player* p : players) delete p;
+
+  Result r;
+  r.score   = b.scr;
+  r.winners = b.winners();
+  r.rounds  = b.round();
+  r.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  for (int pl = 0; pl < np; ++pl) {
+    r.cpu    .push_back(clock.cpu(pl));
+    r.wall   .push_back(clock.wall(pl));
+    r.latency.push_back(clock.latency(pl));
+  }
+  return r;
+}
 
-  cerr << "info: game played" << endl;
+
+void Game::play_round (Board& b, const vector<Player*>& players, vector<Action>& actions,
+                       Play_clock& clock, const Options& opt, ostream& log) {
+  for (int pl = 0; pl < b.num_players(); ++pl) {
+    if (b.stats[pl] == -1) { // Dead
+      actions[pl].clear();
+      continue;
+    }
+
+    log << "info:     start player " << pl << endl;
+    players[pl]->reset(b);
+    clock.start();
+    players[pl]->play();
+    clock.stop(pl);
+    actions[pl] = *players[pl];
+    log << "info:     end player " << pl << endl;
+
+    if (opt.budget > 0) {
+      b.stats[pl] = clock.cpu(pl)/opt.budget;
+      if (b.stats[pl] > 1) {
+        b.stats[pl] = -1;
+        actions[pl].clear();
+        log << "info: player " << b.name(pl) << " exceeded its time budget" << endl;
+      }
+    }
+  }
+}
+
+
+void Game::Result::print (ostream& os) const {
+  os << "score";
+  for (int s : score) os << '\t' << s;
+  os << '\n';
+  os << "winners";
+  for (int pl : winners) os << '\t' << pl;
+  os << '\n';
+  os << "rounds\t" << rounds << '\n';
+  os << "seconds\t" << seconds << '\n';
+  os << "cpu";
+  for (double t : cpu) os << '\t' << t;
+  os << '\n';
+  os << "wall";
+  for (double t : wall) os << '\t' << t;
+  os << '\n';
+  for (int pl = 0; pl < int(latency.size()); ++pl) {
+    os << "latency " << pl;
+    for (int n : latency[pl]) os << '\t' << n;
+    os << '\n';
+  }
 }
@@ -6,6 +6,8 @@
 
 #include "Player.hh"
 #include "Board.hh"
+#include "Replay.hh"
+#include "Play_clock.hh"
 
 
 /**
@@ -15,7 +17,65 @@ class Game {
 
 public:
 
-  static void run (vector<string> names, istream& is, ostream& os, int seed);
+  /**
+   * Final outcome of a match.
+   */
+  struct Result {
+    vector<int> score;   // Final score of each player.
+    vector<int> winners; // Players that got the top score, in increasing order.
+    int         rounds;  // Number of rounds played.
+    double      seconds; // Wall time of the whole match, including loading.
+
+    vector<double>      cpu;     // CPU time of each player in Player::play(), in seconds.
+    vector<double>      wall;    // Wall time of each player in Player::play(), in seconds.
+    vector<vector<int>> latency; // Histogram of each player (see Play_clock::latency).
+
+    /**
+     * Prints the result in text, one field per line.
+     */
+    void print (ostream& os) const;
+  };
+
+  /**
+   * Options of a match.
+   */
+  struct Options {
+    Board::Validation validation; // How the board checks its invariants.
+    bool              binary;     // Write a binary Replay instead of text.
+    bool              quiet;      // Do not log the progress of the match to cerr.
+    double            budget;     // CPU seconds each player can spend in Player::play()
+                                  // during the match, or 0 for no limit.
+
+    Options () : validation(Board::default_validation), binary(false), quiet(false), budget(0) { }
+  };
+
+  /**
+   * Plays a whole match and writes it to os, in text format
+   * or as a binary Replay. The text of each round is written at once.
+   */
+  static void run (vector<string> names, istream& is, ostream& os, int seed,
+                   const Options& opt = Options());
+
+  /**
+   * Plays a whole match in memory, without writing the game anywhere
+   * (headless), and returns its outcome. Options::binary and Options::quiet
+   * are ignored, as nothing is written. Can be called concurrently from
+   * several threads.
+   */
+  static Result play (const vector<string>& names, istream& is, int seed,
+                      const Options& opt = Options());
+
+private:
+
+  /**
+   * Makes the players that are alive play the current round of b, and
+   * stores their actions. Measures their time in Player::play() with clock.
+   * With a budget, sets the status of each player to the fraction of the
+   * budget used, or to -1 (dead) once exceeded. Dead players do not play
+   * anymore, and the actions of the round where they exceed it are ignored.
+   */
+  static void play_round (Board& b, const vector<Player*>& players, vector<Action>& actions,
+                          Play_clock& clock, const Options& opt, ostream& log);
 
 };
 
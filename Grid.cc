@@ -0,0 +1,54 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Grid.hh"
+
+
+long long Grid::new_version () {
+  static atomic<long long> last(0);
+  return ++last;
+}
+
+
+void Grid::restart_tracking () {
+  version      = new_version();
+  changed.clear();
+  is_changed.assign(cells.size(), false);
+  prev_version = 0;  // No version is 0 ...
+  prev_changed = 0;
+  src_version  = -1; // ... or negative.
+  src_changed  = 0;
+  originals    = 0;
+}
+
+
+void Grid::forget_changes () {
+  for (int k : changed) is_changed[k] = false;
+  prev_version = version;
+  prev_changed = changed.size();
+  version      = new_version();
+  changed.clear();
+}
+
+
+void Grid::update (const Grid& src) {
+  int first; // First change of src not applied to this grid yet.
+  if      (src_version == src.version)                                        first = src_changed;
+  else if (src_version == src.prev_version and src_changed == src.prev_changed) first = 0;
+  else                                                                       first = -1;
+
+  if (first == -1) *this = src;
+  else {
+    for (int c = first; c < (int)src.changed.size(); ++c) {
+      int k = src.changed[c];
+      cells[k] = src.cells[k];
+    }
+    // Cells replaced without going through write(): this grid no longer
+    // matches its own version, and its own changes are meaningless.
+    for (int k : changed) is_changed[k] = false;
+    changed.clear();
+    prev_version = 0;
+    version = new_version();
+  }
+  src_version = src.version;
+  src_changed = src.changed.size();
+}
@@ -0,0 +1,235 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Grid_hh
+#define Grid_hh
+
+
+#include "Structs.hh"
+
+
+/**
+ * Contains the Packed_cell struct and the Grid class,
+ * the compact storage behind State::cell().
+ */
+
+
+/**
+ * Compact version of a Cell (8 bytes instead of 24), used to store the board.
+ * Has the same fields as Cell, so it is used in the same way,
+ * and converts to and from Cell.
+ */
+struct Packed_cell {
+
+  CellType    type       : 8;
+  BonusType   bonus      : 8;
+  WeaponType  weapon     : 8;
+  signed char b_owner;
+  short       resistance;
+  short       id;
+
+  /**
+   * Default constructor (Street, NoBonus, NoWeapon, -1, -1, -1).
+   */
+  Packed_cell ();
+
+  /**
+   * Conversion from Cell.
+   */
+  Packed_cell (const Cell& c);
+
+  /**
+   * Conversion to Cell.
+   */
+  operator Cell () const;
+
+  bool is_empty () const;
+};
+
+
+/**
+ * Board stored contiguously in row-major order.
+ * grid[i][j] is the cell at row i and column j.
+ *
+ * Writable access through grid[i][j] records the cell as changed, so that
+ * a copy of the grid can be brought up to date by copying only the cells
+ * that changed since it was last updated (see update).
+ */
+class Grid {
+
+public:
+
+  class Row;
+
+  /**
+   * Empty grid.
+   */
+  Grid ();
+
+  /**
+   * Grid of rows x cols default cells.
+   */
+  Grid (int rows, int cols);
+
+  /**
+   * Copies the cells only. The copy starts its own change tracking.
+   */
+  Grid (const Grid& g);
+  Grid& operator= (const Grid& g);
+
+  int rows () const;
+  int cols () const;
+
+  /**
+   * Returns row i, whose cells are recorded as changed when accessed.
+   */
+  Row operator[] (int i);
+
+  /**
+   * Returns a pointer to the first cell of row i.
+   */
+  const Packed_cell* operator[] (int i) const;
+
+  /**
+   * Starts a new period of change tracking (e.g., a new round).
+   */
+  void forget_changes ();
+
+  /**
+   * Returns the row-major indices of the cells accessed for writing
+   * since the last forget_changes(), in order of first access.
+   */
+  const vector<int>& changes () const;
+
+  /**
+   * While v is not null, appends to v the value of each cell before its
+   * first change, so that v goes along with changes(). Should be set
+   * right after forget_changes(). Assigning the grid resets it.
+   */
+  void keep_originals (vector<Packed_cell>* v);
+
+  /**
+   * Makes this grid equal to src. If this grid was last updated from src
+   * at most one forget_changes() ago, only copies the cells changed since then.
+   */
+  void update (const Grid& src);
+
+private:
+
+  int                 nrows, ncols;
+  vector<Packed_cell> cells;
+
+  long long           version;      // Identifies the cells at the last forget_changes().
+  vector<int>         changed;      // Cells accessed for writing since then.
+  vector<char>        is_changed;   // is_changed[k] iff k is in changed.
+  long long           prev_version; // version and number of changes at the
+  int                 prev_changed; // time of the last forget_changes().
+
+  long long           src_version;  // version and number of changes of the grid
+  int                 src_changed;  // this one was last updated from.
+
+  vector<Packed_cell>* originals;   // See keep_originals, or null.
+
+  /**
+   * Returns a version never used before.
+   */
+  static long long new_version ();
+
+  /**
+   * Resets change tracking, after the cells have been replaced.
+   */
+  void restart_tracking ();
+
+  Packed_cell& write (int k);
+};
+
+
+/**
+ * Writable row of a Grid.
+ */
+class Grid::Row {
+
+public:
+
+  Packed_cell& operator[] (int j) const { return g->write(i*g->ncols + j); }
+
+private:
+
+  friend class Grid;
+
+  Grid* g;
+  int   i;
+
+  Row (Grid* g, int i) : g(g), i(i) { }
+};
+
+
+inline Packed_cell::Packed_cell () :
+  type(Street), bonus(NoBonus), weapon(NoWeapon), b_owner(-1), resistance(-1), id(-1) { }
+
+inline Packed_cell::Packed_cell (const Cell& c) :
+  type(c.type), bonus(c.bonus), weapon(c.weapon), b_owner(c.b_owner), resistance(c.resistance), id(c.id) { }
+
+inline Packed_cell::operator Cell () const {
+  return Cell(type, bonus, weapon, resistance, b_owner, id);
+}
+
+inline bool Packed_cell::is_empty () const {
+  return
+    type == Street and
+    bonus == NoBonus and
+    weapon == NoWeapon and
+    resistance == -1 and
+    b_owner == -1 and
+    id == -1;
+}
+
+inline Grid::Grid () : nrows(0), ncols(0) {
+  restart_tracking();
+}
+
+inline Grid::Grid (int rows, int cols) : nrows(rows), ncols(cols), cells(rows*cols) {
+  restart_tracking();
+}
+
+inline Grid::Grid (const Grid& g) : nrows(g.nrows), ncols(g.ncols), cells(g.cells) {
+  restart_tracking();
+}
+
+inline Grid& Grid::operator= (const Grid& g) {
+  nrows = g.nrows;
+  ncols = g.ncols;
+  cells = g.cells;
+  restart_tracking();
+  return *this;
+}
+
+inline int Grid::rows () const { return nrows; }
+inline int Grid::cols () const { return ncols; }
+
+inline Grid::Row Grid::operator[] (int i) {
+  return Row(this, i);
+}
+
+inline const Packed_cell* Grid::operator[] (int i) const {
+  return &cells[i*ncols];
+}
+
+inline const vector<int>& Grid::changes () const {
+  return changed;
+}
+
+inline void Grid::keep_originals (vector<Packed_cell>* v) {
+  originals = v;
+}
+
+inline Packed_cell& Grid::write (int k) {
+  if (not is_changed[k]) {
+    is_changed[k] = true;
+    changed.push_back(k);
+    if (originals) originals->push_back(cells[k]);
+  }
+  return cells[k];
+}
+
+
+#endif
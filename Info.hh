@@ -73,7 +73,7 @@ public:
     // Read grid with streets, buildings, food, money and weapons
     string l;
     is >> l >> l; // Read 1st and 2nd line of column labels.
-    grid = vector< vector<Cell> >(board_rows(), vector<Cell>(board_cols()));
+    grid = Grid(board_rows(), board_cols());
     
     for (int i = 0; i < board_rows(); ++i) {
       string s;
@@ -94,13 +94,13 @@ public:
       int id, pl, row, col, life;
       is >> type >> id >> pl >> row >> col >> weapon >> life;
       _my_assert(pos_ok(row,col), "Citizen placed out of board");
-      citizens[id] = Citizen(CitizenType(char2CitizenType(type)),id,pl,Pos(row,col),WeaponType(char2WeaponType(weapon)),life);
+      citizens.insert(Citizen(CitizenType(char2CitizenType(type)),id,pl,Pos(row,col),WeaponType(char2WeaponType(weapon)),life));
       _my_assert(grid[row][col].is_empty(), "Citizen placed in non-empty cell");
       grid[row][col].id = id;
-      if (type == 'b') player2builders[pl].insert(id);
+      if (type == 'b') sorted_insert(player2builders[pl], id);
       else {
 	_my_assert(type == 'w', "Wrong type of citizen in grid format");
-	player2warriors[pl].insert(id);
+	sorted_insert(player2warriors[pl], id);
       }
     }
 
@@ -116,7 +116,7 @@ public:
 		 "Barricade placed in non-empty cell");
       grid[row][col].resistance = resist;
       grid[row][col].b_owner = pl;
-      player2barricades[pl].insert(Pos(row,col));
+      sorted_insert(player2barricades[pl], Pos(row,col));
     }
   }
   
@@ -124,6 +124,23 @@ public:
    * Checks invariants are preserved.
    */
   bool ok() const;
+
+  /**
+   * Cheaper version of ok() that only checks what can be broken by changes
+   * to the given cells (row-major indices) and citizens (identifiers,
+   * possibly of killed ones), assuming the rest was ok() before.
+   */
+  bool ok (const vector<int>& cells, const vector<int>& ids) const;
+
+private:
+
+  /**
+   * Parts of ok(): invariants of a single cell, of a single citizen,
+   * and of the round, status and size of the per-player lists.
+   */
+  bool cell_invariants_ok    (int i, int j) const;
+  bool citizen_invariants_ok (const Citizen& ci) const;
+  bool round_and_status_ok   () const;
 };
 
 
@@ -0,0 +1,175 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Legacy_player.hh"
+
+
+/**
+ * The data of the classes of version 1.0, in the same order, so that
+ * they have the same layout. Only what Legacy_player uses is named.
+ *
+ * The symbols of an object built against version 1.0 are renamed to these
+ * classes by inserting the namespace: _ZNK5State4cellEii becomes
+ * _ZNK6Legacy5State4cellEii and _ZTV6Player becomes _ZTVN6Legacy6PlayerE
+ * (with one more _ at the start on macOS), and
+ * _ZN8Registry8RegisterEPKcPFP6PlayervE becomes
+ * _ZN8Registry15register_legacyEPKcPFPN6Legacy6PlayerEvE.
+ */
+namespace Legacy {
+
+  struct Settings {
+    int NUM_PLAYERS, NUM_DAYS, NUM_ROUNDS_PER_DAY, BOARD_ROWS, BOARD_COLS;
+    int NUM_INI_BUILDERS, NUM_INI_WARRIORS, NUM_INI_MONEY, NUM_INI_FOOD, NUM_INI_GUNS, NUM_INI_BAZOOKAS;
+    int BUILDER_INI_LIFE, WARRIOR_INI_LIFE, MONEY_POINTS, KILL_BUILDER_POINTS, KILL_WARRIOR_POINTS, FOOD_INCR_LIFE;
+    int LIFE_LOST_IN_ATTACK, BUILDER_STRENGTH_ATTACK, HAMMER_STRENGTH_ATTACK, GUN_STRENGTH_ATTACK, BAZOOKA_STRENGTH_ATTACK;
+    int BUILDER_STRENGTH_DEMOLISH, HAMMER_STRENGTH_DEMOLISH, GUN_STRENGTH_DEMOLISH, BAZOOKA_STRENGTH_DEMOLISH;
+    int NUM_ROUNDS_REGEN_BUILDER, NUM_ROUNDS_REGEN_WARRIOR, NUM_ROUNDS_REGEN_FOOD, NUM_ROUNDS_REGEN_MONEY, NUM_ROUNDS_REGEN_WEAPON;
+    int BARRICADE_RESISTANCE_STEP, BARRICADE_MAX_RESISTANCE, MAX_NUM_BARRICADES;
+  };
+
+  struct State {
+    vector< vector<Cell> > grid;
+    vector<int>            scr;
+    vector<double>         stats;
+    int                    rnd;
+    bool                   day;
+    map<int, Citizen>      citizens;
+    vector< set<int> >     player2builders;
+    vector< set<int> >     player2warriors;
+    vector< set<Pos> >     player2barricades;
+  };
+
+  struct Info : public Settings, public State { };
+
+  struct Random_generator {
+    long long rnd_seed;
+  };
+
+  struct Action {
+    int             q;
+    set<int>        u;
+    vector<Command> v;
+  };
+
+  class Player : public Info, public Random_generator, public Action {
+  public:
+    virtual void play () = 0;
+    int me_;
+  };
+
+  /**
+   * The data that Dummy adds to Player: its factory initializes the four
+   * directions and INT_MAX after those of Player (472 bytes in all in
+   * AIDummy.o.Linux64).
+   */
+  class Dummy : public Player {
+    vector<Dir> dirs;
+    int         inf;
+  };
+
+  /**
+   * Destroys p as a T, since ~Player is not virtual.
+   */
+  template <typename T>
+  void destroy (Player* p) {
+    T* t = static_cast<T*>(p);
+    t->~T();
+    operator delete(t);
+  }
+}
+
+
+Legacy_player::Deleter Legacy_player::deleter (const string& name) {
+  if (name == "Dummy") return Legacy::destroy<Legacy::Dummy>;
+  return Legacy::destroy<Legacy::Player>; // Frees only the data of Player.
+}
+
+
+Legacy_player::Legacy_player (Legacy::Player* p, Deleter del) :
+  p(p), del(del), started(false) { }
+
+
+Legacy_player::~Legacy_player () {
+  del(p);
+}
+
+
+void Legacy_player::play () {
+  if (not started) {
+    started = true;
+    Legacy::Settings& s = *p;
+    s.NUM_PLAYERS               = num_players();
+    s.NUM_DAYS                  = num_days();
+    s.NUM_ROUNDS_PER_DAY        = num_rounds_per_day();
+    s.BOARD_ROWS                = board_rows();
+    s.BOARD_COLS                = board_cols();
+    s.NUM_INI_BUILDERS          = num_ini_builders();
+    s.NUM_INI_WARRIORS          = num_ini_warriors();
+    s.NUM_INI_MONEY             = num_ini_money();
+    s.NUM_INI_FOOD              = num_ini_food();
+    s.NUM_INI_GUNS              = num_ini_guns();
+    s.NUM_INI_BAZOOKAS          = num_ini_bazookas();
+    s.BUILDER_INI_LIFE          = builder_ini_life();
+    s.WARRIOR_INI_LIFE          = warrior_ini_life();
+    s.MONEY_POINTS              = money_points();
+    s.KILL_BUILDER_POINTS       = kill_builder_points();
+    s.KILL_WARRIOR_POINTS       = kill_warrior_points();
+    s.FOOD_INCR_LIFE            = food_incr_life();
+    s.LIFE_LOST_IN_ATTACK       = life_lost_in_attack();
+    s.BUILDER_STRENGTH_ATTACK   = builder_strength_attack();
+    s.HAMMER_STRENGTH_ATTACK    = hammer_strength_attack();
+    s.GUN_STRENGTH_ATTACK       = gun_strength_attack();
+    s.BAZOOKA_STRENGTH_ATTACK   = bazooka_strength_attack();
+    s.BUILDER_STRENGTH_DEMOLISH = builder_strength_demolish();
+    s.HAMMER_STRENGTH_DEMOLISH  = hammer_strength_demolish();
+    s.GUN_STRENGTH_DEMOLISH     = gun_strength_demolish();
+    s.BAZOOKA_STRENGTH_DEMOLISH = bazooka_strength_demolish();
+    s.NUM_ROUNDS_REGEN_BUILDER  = num_rounds_regen_builder();
+    s.NUM_ROUNDS_REGEN_WARRIOR  = num_rounds_regen_warrior();
+    s.NUM_ROUNDS_REGEN_FOOD     = num_rounds_regen_food();
+    s.NUM_ROUNDS_REGEN_MONEY    = num_rounds_regen_money();
+    s.NUM_ROUNDS_REGEN_WEAPON   = num_rounds_regen_weapon();
+    s.BARRICADE_RESISTANCE_STEP = barricade_resistance_step();
+    s.BARRICADE_MAX_RESISTANCE  = barricade_max_resistance();
+    s.MAX_NUM_BARRICADES        = max_num_barricades();
+
+    // Set by Game and SecGame before the first round.
+    p->me_      = me();
+    p->rnd_seed = rnd_seed;
+  }
+
+  // As Player::reset in version 1.0.
+  Legacy::State& st = *p;
+  int np = num_players();
+  st.grid.assign(board_rows(), vector<Cell>(board_cols()));
+  for (int i = 0; i < board_rows(); ++i)
+    for (int j = 0; j < board_cols(); ++j) st.grid[i][j] = cell(i, j);
+  st.scr  .resize(np);
+  st.stats.resize(np);
+  st.rnd = round();
+  st.day = is_day();
+  st.citizens.clear();
+  st.player2builders  .assign(np, set<int>());
+  st.player2warriors  .assign(np, set<int>());
+  st.player2barricades.assign(np, set<Pos>());
+  for (int pl = 0; pl < np; ++pl) {
+    st.scr  [pl] = score(pl);
+    st.stats[pl] = status(pl);
+    for (int id : builders(pl)) {
+      st.citizens[id] = citizen(id);
+      st.player2builders[pl].insert(id);
+    }
+    for (int id : warriors(pl)) {
+      st.citizens[id] = citizen(id);
+      st.player2warriors[pl].insert(id);
+    }
+    for (Pos q : barricades(pl)) st.player2barricades[pl].insert(q);
+  }
+  Legacy::Action& a = *p;
+  a.q = 0;
+  a.u.clear();
+  a.v.clear();
+
+  p->play();
+
+  for (const Command& c : a.v) execute(c);
+}
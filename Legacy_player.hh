@@ -0,0 +1,70 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Legacy_player_hh
+#define Legacy_player_hh
+
+
+#include "Player.hh"
+
+
+/**
+ * Contains the Legacy_player class, which plays the players that are
+ * only distributed as objects built against the headers of version 1.0
+ * (the AIDummy.o files).
+ */
+
+
+namespace Legacy {
+  class Player;
+}
+
+
+/**
+ * A player of this version that plays a player built against the headers
+ * of version 1.0, whose Info, Action and Player have another layout.
+ *
+ * The classes of version 1.0 are mirrored in namespace Legacy. The symbols
+ * that such an object defines for them would clash with those of this
+ * version, so they are renamed to those of the namespace, and the object
+ * registers its player with Registry::register_legacy instead of
+ * Registry::Register. The AIDummy.o rule of the Makefile does this with
+ * llvm-objcopy --redefine-sym, as described in Legacy_player.cc.
+ *
+ * Each round, the state is copied to the old object before it plays,
+ * and its commands are copied back.
+ */
+class Legacy_player : public Player {
+
+public:
+
+  /**
+   * Frees a player of version 1.0.
+   */
+  typedef void (*Deleter)(Legacy::Player* p);
+
+  /**
+   * Returns the Deleter of the players that the factory registered as
+   * name makes. Players of version 1.0 have no virtual destructor, so
+   * it destroys the class of that player as mirrored in Legacy_player.cc.
+   */
+  static Deleter deleter (const string& name);
+
+  /**
+   * Plays the given player of version 1.0, which is freed with del when
+   * this one is deleted.
+   */
+  Legacy_player (Legacy::Player* p, Deleter del);
+
+  ~Legacy_player ();
+
+  void play ();
+
+private:
+
+  Legacy::Player* p;
+  Deleter         del;
+  bool            started; // Whether the settings have been copied to p.
+};
+
+
+#endif
@@ -1,6 +1,6 @@
 //////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////  
 
-#include "Game.hh"
+#include "Tournament.hh"
 
 
 void help (int argc, char** argv) {
@@ -9,6 +9,16 @@ void help (int argc, char** argv) {
   cout << "--seed=seed     -s seed     set random seed"                   << endl;
   cout << "--input=file    -i input    set input file  (default: stdin)"  << endl;
   cout << "--output=file   -o output   set output file (default: stdout)" << endl;
+  cout << "--validation=v  -V v        check invariants: off, incremental or full" << endl;
+  cout << "--binary        -b          write a binary replay (see replay2txt)" << endl;
+  cout << "--quiet         -q          do not log the progress of the game"     << endl;
+  cout << "--headless      -H          only play the game and write its result" << endl;
+  cout << "--budget=t      -t t        CPU seconds per player (default: no limit)" << endl;
+  cout << "--seeds=A..B                play seeds A to B and write statistics instead of -s" << endl;
+  cout << "--tournament    -T          play a round-robin tournament with seed -s among the players" << endl;
+  cout << "                            (default: all registered) and write their ratings" << endl;
+  cout << "--repeat=k                  play the tournament k times (default: 1)" << endl;
+  cout << "--jobs=n        -j n        games at the same time with --seeds or -T (default: one per core)" << endl;
   cout << "--list          -l          list registered players"           << endl;
   cout << "--version       -v          print version"                     << endl;
   cout << "--help          -h          print help"                        << endl;
@@ -25,6 +35,15 @@ int main (int argc, char** argv) {
     { "seed",    required_argument, 0, 's' },
     { "input",   required_argument, 0, 'i' },
     { "output",  required_argument, 0, 'o' },
+    { "validation", required_argument, 0, 'V' },
+    { "binary",  no_argument,       0, 'b' },
+    { "quiet",   no_argument,       0, 'q' },
+    { "headless", no_argument,      0, 'H' },
+    { "budget",  required_argument, 0, 't' },
+    { "seeds",   required_argument, 0, 'S' },
+    { "tournament", no_argument,    0, 'T' },
+    { "repeat",  required_argument, 0, 'R' },
+    { "jobs",    required_argument, 0, 'j' },
     { "list",    no_argument,       0, 'l' },
     { "version", no_argument,       0, 'v' },
     { "help",    no_argument,       0, 'h' },
@@ -34,11 +53,17 @@ int main (int argc, char** argv) {
   char* ifile = 0;
   char* ofile = 0;
   int seed = -1;
+  int first_seed = -1, last_seed = -1;
+  int jobs = 0;
+  bool tournament = false;
+  int repeat = 1;
+  Game::Options opt;
+  bool headless = false;
   vector<string> names;
 
   while (true) {
     int index = 0;
-    int c = getopt_long(argc, argv, "s:i:o:lvh", long_options, &index);
+    int c = getopt_long(argc, argv, "s:i:o:V:bqHt:Tj:lvh", long_options, &index);
     if (c == -1) break;
 
     switch (c) {
@@ -51,6 +76,42 @@ int main (int argc, char** argv) {
       case 'o':
         ofile = optarg;
         break;
+      case 'V':
+        if      (string(optarg) == "off")         opt.validation = Board::NoValidation;
+        else if (string(optarg) == "incremental") opt.validation = Board::IncrementalValidation;
+        else if (string(optarg) == "full")        opt.validation = Board::FullValidation;
+        else _my_assert(false, "Unknown validation " + string(optarg));
+        break;
+      case 'b':
+        opt.binary = true;
+        break;
+      case 'q':
+        opt.quiet = true;
+        break;
+      case 'H':
+        headless = true;
+        break;
+      case 't':
+        opt.budget = atof(optarg);
+        break;
+      case 'S': {
+        string range = optarg;
+        size_t dots = range.find("..");
+        _my_assert(dots != string::npos, "Seeds should be A..B.");
+        first_seed = string_to_int(range.substr(0, dots));
+        last_seed  = string_to_int(range.substr(dots + 2));
+        _my_assert(0 <= first_seed and first_seed <= last_seed, "Wrong range of seeds.");
+        break;
+      }
+      case 'T':
+        tournament = true;
+        break;
+      case 'R':
+        repeat = string_to_int(optarg);
+        break;
+      case 'j':
+        jobs = string_to_int(optarg);
+        break;
       case 'l':
         Registry::print_players(cout);
         return EXIT_SUCCESS;
@@ -71,12 +132,42 @@ int main (int argc, char** argv) {
     _my_assert(names.back().size() <= 12, "Player name too long.");
   }
 
-  _my_assert(seed >= 0, "Missing seed?");
+  _my_assert(seed >= 0 or first_seed >= 0, "Missing seed?");
 
   istream* is = ifile ? new ifstream(ifile) : &cin;
-  ostream* os = ofile ? new ofstream(ofile) : &cout;
+  ostream* os = ofile ? new ofstream(ofile, opt.binary ? ios::binary : ios::out) : &cout;
 
-  Game::run(names, *is, *os, seed);
+  if (tournament) {
+    if (names.empty()) names = Registry::players();
+    stringstream cnf;
+    cnf << is->rdbuf();
+    int seats = Board(cnf, seed).num_players();
+
+    Tournament t(names, seats, seed, repeat);
+    Runner runner(cnf.str(), jobs, opt);
+    cerr << "info: playing " << t.matches().size() << " games on " << runner.num_threads() << " threads" << endl;
+    Tournament::print(t.play(runner), *os);
+  }
+  else if (first_seed >= 0) {
+    stringstream cnf;
+    cnf << is->rdbuf();
+    vector<Runner::Match> matches;
+    // A long long, as last_seed can be INT_MAX.
+    for (long long s = first_seed; s <= last_seed; ++s) matches.push_back(Runner::Match(names, s));
+
+    Runner runner(cnf.str(), jobs, opt);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<Game::Result> results = runner.run(matches);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    *os << "games\t" << results.size() << '\n';
+    *os << "threads\t" << runner.num_threads() << '\n';
+    *os << "seconds\t" << seconds << '\n';
+    *os << "games/s\t" << results.size()/seconds << '\n';
+    Runner::print_summary(results, names, *os);
+  }
+  else if (headless) Game::play(names, *is, seed, opt).print(*os);
+  else               Game::run(names, *is, *os, seed, opt);
 
   if (ifile) delete is;
   if (ofile) delete os;
@@ -0,0 +1,55 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Play_clock.hh"
+
+#include <ctime>
+
+
+Play_clock::Play_clock (int num_players) :
+  cpu_total (num_players, 0),
+  wall_total(num_players, 0),
+  histogram (num_players, vector<int>(num_buckets, 0)),
+  cpu_start (0) { }
+
+
+double Play_clock::thread_cpu_time () {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec + 1e-9*ts.tv_nsec;
+}
+
+
+void Play_clock::start () {
+  cpu_start  = thread_cpu_time();
+  wall_start = chrono::steady_clock::now();
+}
+
+
+void Play_clock::stop (int pl) {
+  add(pl, thread_cpu_time() - cpu_start,
+      chrono::duration<double>(chrono::steady_clock::now() - wall_start).count());
+}
+
+
+void Play_clock::add (int pl, double cpu, double wall) {
+  cpu_total [pl] += cpu;
+  wall_total[pl] += wall;
+
+  int k = 0;
+  while (k < num_buckets - 1 and wall >= 1e-6*(1LL << k)) ++k;
+  ++histogram[pl][k];
+}
+
+
+void Play_clock::print (ostream& os, const vector<string>& names) const {
+  for (int pl = 0; pl < int(names.size()); ++pl) {
+    os << "info: player " << names[pl]
+       << " cpu " << cpu_total[pl] << " s"
+       << " wall " << wall_total[pl] << " s" << '\n';
+    for (int k = 0; k < num_buckets; ++k)
+      if (histogram[pl][k] > 0) {
+        os << "info:     " << (k < num_buckets - 1 ? "< " : ">= ")
+           << (1LL << (k < num_buckets - 1 ? k : k - 1)) << " us\t" << histogram[pl][k] << '\n';
+      }
+  }
+}
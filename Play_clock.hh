@@ -0,0 +1,93 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Play_clock_hh
+#define Play_clock_hh
+
+
+#include "Utils.hh"
+
+
+/**
+ * Contains the Play_clock class, which measures the time the players
+ * spend in Player::play() during a match.
+ */
+
+
+/**
+ * Accumulates, for each player, the CPU time (of the calling thread)
+ * and the wall time of the measured calls, and a histogram of their
+ * wall time with buckets growing in powers of two.
+ */
+class Play_clock {
+
+public:
+
+  /**
+   * Bucket k counts the calls that took less than 2^k microseconds
+   * (and at least 2^(k-1), if k > 0). The last one also counts longer calls.
+   */
+  static const int num_buckets = 24;
+
+  Play_clock (int num_players);
+
+  /**
+   * Starts measuring a call.
+   */
+  void start ();
+
+  /**
+   * Stops measuring the call started last, made by player pl.
+   */
+  void stop (int pl);
+
+  /**
+   * Adds a call of player pl measured elsewhere (e.g., by the process of the player).
+   */
+  void add (int pl, double cpu, double wall);
+
+  /**
+   * Returns the total CPU and wall time of player pl, in seconds.
+   */
+  double cpu  (int pl) const;
+  double wall (int pl) const;
+
+  /**
+   * Returns the histogram of the wall time of the calls of player pl.
+   */
+  const vector<int>& latency (int pl) const;
+
+  /**
+   * Prints, for each player, the total times and the non-empty buckets of the histogram.
+   */
+  void print (ostream& os, const vector<string>& names) const;
+
+  /**
+   * Returns the CPU time used so far by the calling thread, in seconds.
+   */
+  static double thread_cpu_time ();
+
+private:
+
+  vector<double>      cpu_total;
+  vector<double>      wall_total;
+  vector<vector<int>> histogram;
+
+  double                              cpu_start;
+  chrono::steady_clock::time_point    wall_start;
+};
+
+
+inline double Play_clock::cpu (int pl) const {
+  return cpu_total[pl];
+}
+
+inline double Play_clock::wall (int pl) const {
+  return wall_total[pl];
+}
+
+inline const vector<int>& Play_clock::latency (int pl) const {
+  return histogram[pl];
+}
+
+
+#endif
@@ -10,16 +10,16 @@ void Player::reset (ifstream& is) {
   // THESE DATA STRUCTURES MUST BE RESET: maps WITH clear(), etc.
 
 
-  *(Action*)this = Action();
+  Action::clear();
 
   citizens         .clear();
   player2builders  .clear();
   player2warriors  .clear();
   player2barricades.clear();
   
-  player2builders   = vector<set<int>>(num_players());
-  player2warriors   = vector<set<int>>(num_players());
-  player2barricades = vector<set<Pos>>(num_players());
+  player2builders   = vector<vector<int>>(num_players());
+  player2warriors   = vector<vector<int>>(num_players());
+  player2barricades = vector<vector<Pos>>(num_players());
 
   read_grid(is);
 
@@ -47,6 +47,13 @@ void Player::reset (ifstream& is) {
     _my_assert(st == -1 or (st >= 0 and st <= 1), "Status is not ok.");
   }
 
+  // Pending regenerations are only needed by the board: skip them.
+  is >> s;
+  _my_assert(s == "regeneration", "Expected 'regeneration' while parsing.");
+  int num;
+  is >> num >> s >> s >> s >> s; // Read "kind type player rounds"
+  for (int k = 0; k < num; ++k) is >> s >> s >> s >> s;
+
   _my_assert(ok(), "Invariants are not satisfied.");
   //  forget();
 }
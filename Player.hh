@@ -16,6 +16,10 @@
  *
  * In order to create new players, inherit from this class and register them.
  * See for example AINull.cc and AIDemo.cc.
+ *
+ * To look ahead, a player can include Board.hh, build a Board from its
+ * Info and simulate rounds on it with Board::next, going back with
+ * Board::save and Board::restore.
  */
 class Player : public Info, public Random_generator, public Action {
 
@@ -38,6 +42,11 @@ public:
    * Empty constructor.
    */
   Player () { }
+
+  /**
+   * Virtual destructor, so that players can be deleted through a Player*.
+   */
+  virtual ~Player () { }
   
 private: 
 
@@ -47,8 +56,8 @@ private:
   int me_;
 
   inline void reset (const Info& info) {
-    *static_cast<Action*>(this) = Action();
-    *static_cast<State*>(this) = (State) info;
+    Action::clear();
+    State::update(info);
     //    forget();
   }
 
@@ -31,10 +31,19 @@ private:
   friend class Board;
   friend class Game;
   friend class SecGame;
+  friend class Legacy_player;
+  friend class Bench_random;
 
   static const long long RANDOM_MOD = ((long long)1)<<31;
   static const long long RANDOM_MASK = RANDOM_MOD - 1;
 
+  // One step of the generator is x -> (RANDOM_MUL*x + RANDOM_ADD) mod RANDOM_MOD,
+  // and each call to random() takes two: x -> (RANDOM_MUL2*x + RANDOM_ADD2) mod RANDOM_MOD.
+  static const long long RANDOM_MUL  = 843314861;
+  static const long long RANDOM_ADD  = 453816693;
+  static const long long RANDOM_MUL2 = (RANDOM_MUL*RANDOM_MUL) & RANDOM_MASK;
+  static const long long RANDOM_ADD2 = (RANDOM_MUL*RANDOM_ADD + RANDOM_ADD) & RANDOM_MASK;
+
   long long rnd_seed;
 
   /**
@@ -49,7 +58,7 @@ private:
    * Computes next seed from current seed.
    */
   void next_rnd () {
-    rnd_seed = (843314861*rnd_seed + 453816693) & RANDOM_MASK;
+    rnd_seed = (RANDOM_MUL*rnd_seed + RANDOM_ADD) & RANDOM_MASK;
   }
 
   /**
@@ -69,8 +78,10 @@ inline int Random_generator::random (int l, int u) {
     long long m = (long long)u - (long long)l + 1;
     if (m > 1e6) return l; // interval too long
 
-    next_rnd();
-    return l + int((u - l + 1)*uniform()); //...
+    // Same as next_rnd() and then l + int(m*uniform()), since m*rnd_seed < 2^51
+    // is exact in a double and dividing by RANDOM_MOD is a shift.
+    rnd_seed = (RANDOM_MUL2*rnd_seed + RANDOM_ADD2) & RANDOM_MASK;
+    return l + int((m*rnd_seed) >> 31);
   }
 
   /**
@@ -0,0 +1,128 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Regen_positions.hh"
+
+
+void Regen_positions::build (const Grid& g) {
+  if (log) log->built = true;
+  nrows = g.rows();
+  ncols = g.cols();
+  int n = nrows*ncols;
+  occupied.assign(n, false);
+  near    .assign(n, 0);
+  good    .assign(n, false);
+  tree    .assign(n + 1, 0);
+  num_good = 0;
+
+  for (int i = 0; i < nrows; ++i)
+    for (int j = 0; j < ncols; ++j)
+      if (g[i][j].id != -1) {
+        occupied[i*ncols + j] = true;
+        add_near(i, j, 1);
+      }
+
+  for (int k = 0; k < n; ++k) {
+    good[k] = g[k / ncols][k % ncols].is_empty() and near[k] == 0;
+    num_good += good[k];
+    tree[k + 1] += good[k];
+    int parent = (k + 1) + ((k + 1) & -(k + 1));
+    if (parent <= n) tree[parent] += tree[k + 1];
+  }
+}
+
+
+void Regen_positions::refresh (const Grid& g, int k) {
+  bool now = g[k / ncols][k % ncols].is_empty() and near[k] == 0;
+  if (now == bool(good[k])) return;
+
+  if (log) log->good.push_back(k);
+  flip_good(k);
+}
+
+
+void Regen_positions::flip_good (int k) {
+  good[k] = not good[k];
+  int delta = good[k] ? 1 : -1;
+  num_good += delta;
+  for (int x = k + 1; x <= nrows*ncols; x += x & -x) tree[x] += delta;
+}
+
+
+void Regen_positions::add_near (int i, int j, int d) {
+  for (int ii = max(i - 2, 0); ii <= min(i + 2, nrows - 1); ++ii)
+    for (int jj = max(j - 2, 0); jj <= min(j + 2, ncols - 1); ++jj)
+      near[ii*ncols + jj] += d;
+}
+
+
+void Regen_positions::sync (const Grid& g) {
+  if (g.rows() != nrows or g.cols() != ncols or occupied.empty()) {
+    build(g);
+    return;
+  }
+
+  // A cell may have changed more than once since the last sync, so each
+  // changed cell is compared with what the set knows about it.
+  // All the counts are updated before any cell is refreshed, so that a cell
+  // near a citizen that moved one step is not refreshed twice in between.
+  moved.clear();
+  for (int k : g.changes()) {
+    bool occ = g[k / ncols][k % ncols].id != -1;
+    if (occ != bool(occupied[k])) {
+      if (log) log->occupied.push_back(k);
+      occupied[k] = occ;
+      add_near(k / ncols, k % ncols, occ ? 1 : -1);
+      moved.push_back(k);
+    }
+  }
+  for (int k : g.changes()) refresh(g, k);
+  for (int k : moved) {
+    int i = k / ncols, j = k % ncols;
+    for (int ii = max(i - 2, 0); ii <= min(i + 2, nrows - 1); ++ii)
+      for (int jj = max(j - 2, 0); jj <= min(j + 2, ncols - 1); ++jj)
+        refresh(g, ii*ncols + jj);
+  }
+}
+
+
+void Regen_positions::keep_log (Log* l) {
+  log = l;
+  if (log) {
+    log->built = false;
+    log->occupied.clear();
+    log->good.clear();
+  }
+}
+
+
+void Regen_positions::undo (const Log& l) {
+  // The grid was scanned for the first time: the next sync scans it again.
+  if (l.built) {
+    occupied.clear();
+    return;
+  }
+
+  // Flips and additions commute, so the order does not matter.
+  for (int k : l.occupied) {
+    occupied[k] = not occupied[k];
+    add_near(k / ncols, k % ncols, occupied[k] ? 1 : -1);
+  }
+  for (int k : l.good) flip_good(k);
+}
+
+
+Pos Regen_positions::nth (int k) const {
+  _my_assert(0 <= k and k < num_good, "Wrong index of regeneration position.");
+
+  // Descends the Fenwick tree looking for the last prefix with at most k good cells.
+  int n = nrows*ncols;
+  int x = 0;
+  int step = 1;
+  while (2*step <= n) step *= 2;
+  for (; step > 0; step /= 2)
+    if (x + step <= n and tree[x + step] <= k) {
+      x += step;
+      k -= tree[x];
+    }
+  return Pos(x / ncols, x % ncols);
+}
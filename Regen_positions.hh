@@ -0,0 +1,112 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Regen_positions_hh
+#define Regen_positions_hh
+
+
+#include "Grid.hh"
+
+
+/**
+ * Contains the Regen_positions class, used by the Board to choose
+ * where to regenerate bonus, weapons and citizens.
+ */
+
+
+/**
+ * Set of the positions of a Grid where something can be regenerated:
+ * empty cells with no citizen in the 5x5 square centered at them.
+ *
+ * Stores, for every cell, the number of citizens in that square,
+ * and a Fenwick tree over the good cells, so that the k-th good cell in
+ * row-major order is found in O(log(rows*cols)).
+ * It is kept up to date from the cells changed in the grid (see sync).
+ */
+class Regen_positions {
+
+public:
+
+  Regen_positions ();
+
+  /**
+   * What syncs changed, to undo it: the cells whose number of citizens
+   * in their square, or whether they are good, changed.
+   */
+  struct Log {
+    bool        built;     // Whether a sync scanned the whole grid.
+    vector<int> occupied;  // Cells that gained or lost a citizen, in order.
+    vector<int> good;      // Cells that became good or stopped being, in order.
+
+    Log () : built(false) { }
+  };
+
+  /**
+   * Starts recording in log what the following syncs change
+   * (clearing it first), or stops if log is null.
+   */
+  void keep_log (Log* log);
+
+  /**
+   * Undoes what the syncs recorded in log changed, which must be the
+   * last ones. Takes time proportional to the size of log.
+   */
+  void undo (const Log& log);
+
+  /**
+   * Brings the set up to date with g. Must be called before a round
+   * forgets its changes (see Grid::forget_changes), unless g is rebuilt.
+   * The first time (or if the size of g changes) scans the whole grid.
+   */
+  void sync (const Grid& g);
+
+  /**
+   * Returns the number of good positions.
+   */
+  int size () const;
+
+  /**
+   * Returns the k-th good position in row-major order, with 0 <= k < size().
+   */
+  Pos nth (int k) const;
+
+private:
+
+  int                   nrows, ncols;
+  vector<char>          occupied;  // Whether the cell had a citizen at the last sync.
+  vector<unsigned char> near;      // Citizens in the 5x5 square centered at the cell.
+  vector<char>          good;      // Whether the cell is a good position.
+  vector<int>           tree;      // Fenwick tree over good, 1-based.
+  int                   num_good;
+  Log*                  log;       // See keep_log, or null.
+  vector<int>           moved;     // Cells whose citizen came or left, during a sync.
+
+  /**
+   * Scans the whole grid.
+   */
+  void build (const Grid& g);
+
+  /**
+   * Recomputes whether cell k is good.
+   */
+  void refresh (const Grid& g, int k);
+
+  /**
+   * Flips whether cell k is good.
+   */
+  void flip_good (int k);
+
+  /**
+   * Adds d to the number of citizens near every cell whose square has cell (i, j).
+   */
+  void add_near (int i, int j, int d);
+};
+
+
+inline Regen_positions::Regen_positions () : nrows(0), ncols(0), num_good(0), log(0) { }
+
+inline int Regen_positions::size () const {
+  return num_good;
+}
+
+
+#endif
@@ -14,6 +14,10 @@
 
 class Player;
 
+namespace Legacy {
+  class Player;
+}
+
 
 /**
  * Since the main program does not know how many players will be inherited
@@ -27,10 +31,19 @@ public:
 
   static int Register (const char* name, Factory fact);
 
+  /**
+   * Registers a player built against the headers of version 1.0, which is
+   * played by a Legacy_player (see there).
+   */
+  typedef Legacy::Player* (*Legacy_factory)();
+  static int register_legacy (const char* name, Legacy_factory fact);
+
   static Player* new_player (string name);
 
   static void print_players (ostream& os);
 
+  static vector<string> players ();
+
 };
 
 
@@ -0,0 +1,128 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Replay.hh"
+
+
+const string Replay::magic  = "ThePurgeReplay";
+const int    Replay::format = 1;
+
+
+Replay::Replay (ostream& os, const Board& b, int seed) :
+  os(os),
+  state(b.board_rows(), b.board_cols(), b.num_players()) {
+
+  os.write(magic.data(), magic.size());
+  write_varint(os, format);
+  write_signed_varint(os, seed);
+
+  ostringstream settings;
+  b.print_settings(settings);
+  write_string(os, settings.str());
+
+  write_varint(os, b.num_players());
+  for (int pl = 0; pl < b.num_players(); ++pl) write_string(os, b.name(pl));
+
+  write_changes(b, true);
+}
+
+
+void Replay::add_round (const Board& b) {
+  write_varint(os, b.commands_done.size());
+  for (const Command& m : b.commands_done) {
+    write_varint(os, m.id);
+    os.put(char(m.c_type));
+    os.put(char(m.dir));
+  }
+  write_changes(b, false);
+}
+
+
+void Replay::write_changes (const Board& b, bool all_cells) {
+  state.write(os, b, all_cells);
+
+  // Pending regenerations, which are few
+  write_varint(os, b.citizens_to_regenerate.size());
+  for (const auto& p : b.citizens_to_regenerate) {
+    os.put(char(p.first.first));
+    write_varint(os, p.first.second);
+    write_varint(os, p.second);
+  }
+  write_varint(os, b.bonus_to_regenerate.size());
+  for (const auto& p : b.bonus_to_regenerate) {
+    os.put(char(p.first));
+    write_varint(os, p.second);
+  }
+  write_varint(os, b.weapons_to_regenerate.size());
+  for (const auto& p : b.weapons_to_regenerate) {
+    os.put(char(p.first));
+    write_varint(os, p.second);
+  }
+}
+
+
+// Only what Board::print_state uses is read: the per-player lists are not kept.
+void Replay::read_changes (istream& is, Board& b) {
+  State_delta::read(is, b, false);
+
+  b.citizens_to_regenerate.resize(read_varint(is));
+  for (auto& p : b.citizens_to_regenerate) {
+    p.first.first  = CitizenType(read_byte(is));
+    p.first.second = read_varint(is);
+    p.second       = read_varint(is);
+  }
+  b.bonus_to_regenerate.resize(read_varint(is));
+  for (auto& p : b.bonus_to_regenerate) {
+    p.first  = BonusType(read_byte(is));
+    p.second = read_varint(is);
+  }
+  b.weapons_to_regenerate.resize(read_varint(is));
+  for (auto& p : b.weapons_to_regenerate) {
+    p.first  = WeaponType(read_byte(is));
+    p.second = read_varint(is);
+  }
+}
+
+
+void Replay::to_text (istream& is, ostream& os) {
+  string m(magic.size(), ' ');
+  is.read(&m[0], m.size());
+  _my_assert(is and m == magic, "Not a binary replay.");
+  _my_assert(read_varint(is) == (unsigned long long)format, "Unsupported version of binary replay.");
+  int seed = read_signed_varint(is);
+
+  Board b;
+  istringstream settings(read_string(is));
+  *static_cast<Settings*>(&b) = Settings::read_settings(settings);
+
+  _my_assert(int(read_varint(is)) == b.num_players(), "Wrong number of names in binary replay.");
+  b.names = vector<string>(b.num_players());
+  for (string& name : b.names) name = read_string(is);
+
+  b.grid  = Grid(b.board_rows(), b.board_cols());
+  b.scr   = vector<int>   (b.num_players(), 0);
+  b.stats = vector<double>(b.num_players(), 0);
+  read_changes(is, b);
+
+  // As Game::run
+  os << "Game" << '\n' << '\n';
+  os << "Seed " << seed << '\n' << '\n';
+  b.print_settings(os);
+  b.print_names(os);
+  b.print_state(os);
+
+  while (is.peek() != EOF) {
+    vector<Command> commands;
+    int num = read_varint(is);
+    for (int n = 0; n < num; ++n) {
+      int id     = read_varint(is);
+      int c_type = read_byte(is);
+      int dir    = read_byte(is);
+      commands.push_back(Command(id, c_type, dir));
+    }
+    read_changes(is, b);
+
+    os << "commands" << '\n';
+    Action::print(commands, os);
+    b.print_state(os);
+  }
+}
@@ -0,0 +1,67 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Replay_hh
+#define Replay_hh
+
+
+#include "Board.hh"
+#include "State_delta.hh"
+
+
+/**
+ * Contains the Replay class, which writes games in a compact binary format
+ * and converts them back to the text format read by the viewer.
+ */
+
+
+/**
+ * Writes a game in binary as it is played.
+ *
+ * The binary replay starts with the seed, the settings and the names,
+ * followed by the initial state and then one record per round, with the
+ * commands performed and what changed in the state: cells, citizens,
+ * scores, status and pending regenerations. to_text() produces exactly
+ * the output of Game::run for the same game.
+ */
+class Replay {
+
+public:
+
+  /**
+   * Starts the binary replay in os of a game on board b, with the given seed.
+   */
+  Replay (ostream& os, const Board& b, int seed);
+
+  /**
+   * Appends the round just played on b by Board::next.
+   */
+  void add_round (const Board& b);
+
+  /**
+   * Reads a binary replay from is and writes it to os in text format.
+   */
+  static void to_text (istream& is, ostream& os);
+
+private:
+
+  static const string magic;   // Start of every binary replay.
+  static const int    format;  // Version of the binary format.
+
+  ostream& os;
+
+  State_delta state;
+
+  /**
+   * Writes what changed in b since the last call, checking only
+   * the changed cells of b's grid unless all_cells.
+   */
+  void write_changes (const Board& b, bool all_cells);
+
+  /**
+   * Applies to b changes written by write_changes.
+   */
+  static void read_changes (istream& is, Board& b);
+};
+
+
+#endif
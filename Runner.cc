@@ -0,0 +1,70 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////  
+
+#include "Runner.hh"
+
+
+Runner::Runner (const string& cnf, int num_threads, const Game::Options& opt) :
+  cnf(cnf), threads(num_threads), opt(opt) {
+  if (threads <= 0) threads = max(1, int(thread::hardware_concurrency()));
+}
+
+
+vector<Game::Result> Runner::run (const vector<Match>& matches) const {
+  return run(matches, [](int, const Game::Result&) { return true; });
+}
+
+
+vector<Game::Result> Runner::run (const vector<Match>& matches,
+                                  const function<bool (int, const Game::Result&)>& done) const {
+  int n = matches.size();
+  vector<Game::Result> results(n);
+
+  // Each worker repeatedly takes the first match nobody has started yet.
+  atomic<int>  next(0);
+  atomic<bool> stop(false);
+  mutex        m;
+  auto work = [&]() {
+    for (int k = next++; k < n and not stop; k = next++) {
+      istringstream is(cnf);
+      results[k] = Game::play(matches[k].names, is, matches[k].seed, opt);
+
+      lock_guard<mutex> lock(m);
+      if (not stop and not done(k, results[k])) stop = true;
+    }
+  };
+
+  vector<thread> workers;
+  for (int t = 0; t < min(threads, n); ++t) workers.push_back(thread(work));
+  for (thread& w : workers) w.join();
+
+  return results;
+}
+
+
+void Runner::print_summary (const vector<Game::Result>& results, const vector<string>& names,
+                            ostream& os) {
+  const double z = 1.959964; // 95%, two-sided
+
+  int n = results.size();
+  int np = names.size();
+  os << "player\tname\tmean\tstddev\twins\twin%\t95% CI" << '\n';
+  for (int pl = 0; pl < np; ++pl) {
+    double sum = 0, sum2 = 0, wins = 0;
+    for (const Game::Result& r : results) {
+      sum  += r.score[pl];
+      sum2 += double(r.score[pl])*r.score[pl];
+      if (find(r.winners.begin(), r.winners.end(), pl) != r.winners.end())
+        wins += 1.0/r.winners.size();
+    }
+    double mean   = n ? sum/n : 0;
+    double stddev = n > 1 ? sqrt(max(0.0, (sum2 - n*mean*mean)/(n - 1))) : 0;
+    double p      = n ? wins/n : 0;
+    double center = n ? (p + z*z/(2*n))/(1 + z*z/n) : 0;
+    double half   = n ? z*sqrt(p*(1 - p)/n + z*z/(4.0*n*n))/(1 + z*z/n) : 0;
+
+    os << pl << '\t' << names[pl] << '\t'
+       << fixed << setprecision(1) << mean << '\t' << stddev << '\t' << wins << '\t'
+       << 100*p << '\t' << 100*(center - half) << ".." << 100*(center + half) << '\n';
+    os.unsetf(ios::fixed);
+  }
+}
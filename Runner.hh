@@ -0,0 +1,79 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////  
+
+#ifndef Runner_hh
+#define Runner_hh
+
+
+#include "Game.hh"
+
+
+/**
+ * Contains a class to play batches of matches in-process and in parallel.
+ */
+
+
+/**
+ * Plays many matches on a fixed number of worker threads,
+ * keeping all the results in memory.
+ */
+class Runner {
+
+public:
+
+  /**
+   * Description of a match: the names of the players, in seat order, and its seed.
+   */
+  struct Match {
+    vector<string> names;
+    int            seed;
+
+    Match (const vector<string>& names, int seed) : names(names), seed(seed) { }
+  };
+
+  /**
+   * Creates a runner for the game settings in cnf (the contents of a
+   * configuration file such as default.cnf). A num_threads <= 0 means
+   * one thread per hardware thread. Every match is played with opt.
+   */
+  Runner (const string& cnf, int num_threads = 0, const Game::Options& opt = Game::Options());
+
+  /**
+   * Returns the number of worker threads.
+   */
+  int num_threads () const;
+
+  /**
+   * Plays all the matches and returns their results, in the same order.
+   */
+  vector<Game::Result> run (const vector<Match>& matches) const;
+
+  /**
+   * Same, but calls done(k, result) as each match k finishes, one call at
+   * a time. Once done returns false no more matches are started, and done
+   * is not called again. Matches that were not played have an empty score.
+   */
+  vector<Game::Result> run (const vector<Match>& matches,
+                            const function<bool (int, const Game::Result&)>& done) const;
+
+  /**
+   * Prints, for each player of results of matches with the given names,
+   * the mean and standard deviation of its score, and its rate of wins with
+   * a 95% confidence interval (Wilson). A tie for the top score between
+   * k players counts as 1/k of a win for each.
+   */
+  static void print_summary (const vector<Game::Result>& results, const vector<string>& names,
+                             ostream& os);
+
+private:
+
+  string        cnf;
+  int           threads;
+  Game::Options opt;
+};
+
+
+inline int Runner::num_threads () const {
+  return threads;
+}
+
+#endif
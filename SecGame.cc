@@ -0,0 +1,396 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "SecGame.hh"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+
+const string SecGame::magic  = "ThePurgeSecGame";
+const int    SecGame::format = 1;
+
+
+typedef chrono::steady_clock::time_point Time;
+
+static const Time never = Time::max();
+
+// Time after the given number of seconds from now, or never if 0.
+static Time deadline_after (double seconds) {
+  if (seconds <= 0) return never;
+  return chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(
+    chrono::duration<double>(seconds));
+}
+
+// Waits until fd is ready for events. Returns false if it is not by the deadline,
+// so a fd that is ready is still used after the deadline passed.
+static bool wait_for (int fd, short events, Time deadline) {
+  while (true) {
+    int ms = -1;
+    if (deadline != never) {
+      double left = chrono::duration<double>(deadline - chrono::steady_clock::now()).count();
+      ms = max(0.0, ceil(1000*left));
+    }
+    pollfd p = { fd, events, 0 };
+    int r = poll(&p, 1, ms);
+    if (r > 0) return true; // Also on errors, which the next read or write reports.
+    if (r == 0 and ms == 0) return false;
+    if (r < 0 and errno != EINTR) return false;
+  }
+}
+
+// Writes all of s to fd. Returns false on errors or if the deadline passes first.
+static bool write_all (int fd, const string& s, Time deadline) {
+  size_t done = 0;
+  while (done < s.size()) {
+    if (not wait_for(fd, POLLOUT, deadline)) return false;
+    ssize_t n = write(fd, s.data() + done, s.size() - done);
+    if (n < 0 and (errno == EINTR or errno == EAGAIN)) continue;
+    if (n <= 0) return false;
+    done += n;
+  }
+  return true;
+}
+
+
+/**
+ * Buffer of an istream that reads from a file descriptor,
+ * with end of file once a deadline passes.
+ */
+class Fd_input : public streambuf {
+
+public:
+
+  Fd_input (int fd) : fd(fd), deadline(never) {
+    setg(buf, buf, buf);
+  }
+
+  void set_deadline (Time t) {
+    deadline = t;
+  }
+
+protected:
+
+  int_type underflow () {
+    while (gptr() == egptr()) {
+      if (not wait_for(fd, POLLIN, deadline)) return traits_type::eof();
+      ssize_t n = read(fd, buf, sizeof(buf));
+      if (n < 0 and (errno == EINTR or errno == EAGAIN)) continue;
+      if (n <= 0) return traits_type::eof();
+      setg(buf, buf, buf + n);
+    }
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+
+  int  fd;
+  Time deadline;
+  char buf[1 << 16];
+};
+
+
+// What comes from the program of a player can be anything, so
+// these return false instead of failing as read_varint and the like.
+
+static bool get_varint (istream& is, unsigned long long& x) {
+  x = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int c = is.get();
+    if (c == EOF) return false;
+    x |= (unsigned long long)(c & 127) << shift;
+    if (c < 128) return true;
+  }
+  return false;
+}
+
+static bool get_int (istream& is, int& x) {
+  unsigned long long u;
+  if (not get_varint(is, u)) return false;
+  long long v = u & 1 ? -(long long)(u >> 1) - 1 : (long long)(u >> 1);
+  if (v < INT_MIN or v > INT_MAX) return false;
+  x = v;
+  return true;
+}
+
+static bool get_double (istream& is, double& d) {
+  unsigned char b[8];
+  if (not is.read((char*)b, 8)) return false;
+  unsigned long long x = 0;
+  for (int k = 0; k < 8; ++k) x |= (unsigned long long)b[k] << (8*k);
+  memcpy(&d, &x, 8);
+  return true;
+}
+
+
+SecGame::Process SecGame::start (const string& program, const Options& opt) {
+  // Closed on exec, so that a player does not inherit the pipes of the others.
+  // (pipe2 would do it at once, but it is not available on macOS.)
+  int to[2], from[2];
+  _my_assert(pipe(to) == 0 and pipe(from) == 0, "Cannot create pipes.");
+  for (int fd : { to[0], to[1], from[0], from[1] }) fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+  pid_t pid = fork();
+  _my_assert(pid != -1, "Cannot create a process.");
+  if (pid == 0) {
+    // Standard input and descriptor 3 are the pipes, and what the
+    // player writes to cout goes to cerr. Nothing else is inherited.
+    dup2(to[0], 0);
+    if (from[1] == 3) fcntl(3, F_SETFD, 0);
+    else              dup2(from[1], 3);
+    dup2(2, 1);
+
+    rlimit core = { 0, 0 };
+    setrlimit(RLIMIT_CORE, &core);
+    if (opt.budget > 0) {
+      // Only a backstop: the budget is enforced with the times the player reports.
+      rlim_t s = rlim_t(ceil(opt.budget)) + 1;
+      rlimit cpu = { s, s + 1 };
+      setrlimit(RLIMIT_CPU, &cpu);
+    }
+
+    execl(program.c_str(), program.c_str(), "--serve", (char*)0);
+    _exit(127);
+  }
+
+  close(to[0]);
+  close(from[1]);
+  fcntl(to[1],   F_SETFL, O_NONBLOCK);
+  fcntl(from[0], F_SETFL, O_NONBLOCK);
+
+  Process p;
+  p.pid  = pid;
+  p.to   = to[1];
+  p.from = from[0];
+  return p;
+}
+
+
+void SecGame::stop (Process& p) {
+  if (p.pid == -1) return;
+  kill(p.pid, SIGKILL);
+  close(p.to);
+  close(p.from);
+  waitpid(p.pid, 0, 0);
+  p.pid = -1;
+}
+
+
+bool SecGame::read_answer (istream& is, Action& a, double& cpu, double& wall) {
+  unsigned long long num;
+  if (not get_double(is, cpu) or not get_double(is, wall)) return false;
+  if (not get_varint(is, num) or num > (unsigned long long)Action::MAX_COMMANDS) return false;
+  for (unsigned long long k = 0; k < num; ++k) {
+    int id, c_type, dir;
+    if (not get_int(is, id) or not get_int(is, c_type) or not get_int(is, dir)) return false;
+    a.execute(Command(id, c_type, dir));
+  }
+  return true;
+}
+
+
+void SecGame::run (const vector<string>& programs, istream& is, ostream& os, int seed,
+                   const Options& opt) {
+  // Progress messages, unless quiet.
+  ostream log(opt.quiet ? 0 : cerr.rdbuf());
+
+  // Writing to the pipe of a dead player must not end the game.
+  signal(SIGPIPE, SIG_IGN);
+
+  log << "info: seed " << seed << endl;
+
+  log << "info: loading game" << endl;
+  Board b(is, seed);
+  log << "info: loaded game" << endl;
+
+  int np = b.num_players();
+  int nr = b.num_rounds();
+
+  _my_assert(np == (int)programs.size(), "Wrong number of players.");
+
+  vector<Process>   procs(np);
+  vector<Fd_input*> input(np);
+  for (int pl = 0; pl < np; ++pl) {
+    log << "info: starting " << programs[pl] << endl;
+    procs[pl] = start(programs[pl], opt);
+    input[pl] = new Fd_input(procs[pl].from);
+  }
+
+  auto die = [&](int pl, const string& why) {
+    log << "info: player " << b.name(pl) << " " << why << endl;
+    b.stats[pl] = -1;
+    stop(procs[pl]);
+  };
+
+  ostringstream settings;
+  b.print_settings(settings);
+  for (int pl = 0; pl < np; ++pl) {
+    input[pl]->set_deadline(deadline_after(opt.round_timeout()));
+    istream in(input[pl]);
+    unsigned long long size;
+    string name;
+    bool ok = get_varint(in, size) and size <= 12;
+    if (ok) {
+      name = string(size, ' ');
+      ok = bool(in.read(&name[0], size));
+    }
+    if (not ok) {
+      // Named after its program, as in AIName.exe.
+      name = programs[pl].substr(programs[pl].rfind('/') + 1);
+      if (name.compare(0, 2, "AI") == 0) name = name.substr(2);
+      if (name.size() > 4 and name.compare(name.size() - 4, 4, ".exe") == 0) name.resize(name.size() - 4);
+    }
+    b.names[pl] = name;
+    if (not ok) {
+      die(pl, "does not play");
+      continue;
+    }
+    log << "info: loaded player " << b.names[pl] << endl;
+
+    ostringstream msg;
+    msg.write(magic.data(), magic.size());
+    write_varint(msg, format);
+    write_varint(msg, pl);
+    write_signed_varint(msg, seed + pl + 1); // As Game::run
+    write_string(msg, settings.str());
+    if (not write_all(procs[pl].to, msg.str(), deadline_after(opt.round_timeout()))) die(pl, "does not play");
+  }
+  log << "info: players loaded" << endl;
+
+  // As Game::run
+  ostringstream text;
+
+  Replay* replay = 0;
+  if (opt.binary) replay = new Replay(os, b, seed);
+  else {
+    text << "Game" << '\n' << '\n';
+    text << "Seed " << seed << '\n' << '\n';
+    b.print_settings(text);
+    b.print_names(text);
+    b.print_state(text);
+    os << text.str();
+  }
+
+  State_delta    delta(b.board_rows(), b.board_cols(), np);
+  Play_clock     clock(np);
+  vector<Action> actions(np); // Reused from round to round.
+  for (int round = 0; round < nr; ++round) {
+    log << "info: start round " << round << endl;
+
+    // All the players are sent the round first, so that they play at the same time.
+    ostringstream msg;
+    delta.write(msg, b, round == 0);
+    Time deadline = deadline_after(opt.round_timeout());
+    for (int pl = 0; pl < np; ++pl)
+      if (b.stats[pl] != -1 and not write_all(procs[pl].to, msg.str(), deadline))
+        die(pl, "does not read the round");
+
+    for (int pl = 0; pl < np; ++pl) {
+      actions[pl].clear();
+      if (b.stats[pl] == -1) continue;
+
+      input[pl]->set_deadline(deadline);
+      istream in(input[pl]);
+      double cpu, wall;
+      if (not read_answer(in, actions[pl], cpu, wall)) {
+        actions[pl].clear();
+        die(pl, "does not answer");
+        continue;
+      }
+      clock.add(pl, cpu, wall);
+
+      if (opt.budget > 0) {
+        b.stats[pl] = clock.cpu(pl)/opt.budget;
+        if (b.stats[pl] > 1) {
+          actions[pl].clear();
+          die(pl, "exceeded its time budget");
+        }
+      }
+    }
+
+    if (opt.binary) {
+      b.next(actions);
+      replay->add_round(b);
+    }
+    else {
+      text.str("");
+      b.next(actions, text);
+      b.print_state(text);
+      os << text.str();
+    }
+    log << "info: end round " << round << endl;
+  }
+  delete replay;
+  os.flush();
+
+  for (int pl = 0; pl < np; ++pl) {
+    stop(procs[pl]);
+    delete input[pl];
+  }
+
+  b.print_results();
+  clock.print(cerr, b.names);
+
+  log << "info: game played" << endl;
+}
+
+
+void SecGame::serve (int in, int out) {
+  vector<string> names = Registry::players();
+  _my_assert(names.size() == 1, "The program of a player must have exactly one player.");
+  Player* p = Registry::new_player(names[0]);
+
+  ostringstream msg;
+  write_string(msg, names[0]);
+  _my_assert(write_all(out, msg.str(), never), "Cannot write to the game.");
+
+  Fd_input buf(in);
+  istream  is(&buf);
+
+  string m(magic.size(), ' ');
+  is.read(&m[0], m.size());
+  _my_assert(is and m == magic, "Not started by SecGame.");
+  _my_assert(read_varint(is) == (unsigned long long)format, "Unsupported version of SecGame.");
+  p->me_ = read_varint(is);
+  p->set_random_seed(read_signed_varint(is));
+  istringstream settings(read_string(is));
+  *static_cast<Settings*>(p) = Settings::read_settings(settings);
+
+  int np = p->num_players();
+  p->grid              = Grid(p->board_rows(), p->board_cols());
+  p->scr               = vector<int>        (np, 0);
+  p->stats             = vector<double>     (np, 0);
+  p->player2builders   = vector<vector<int>>(np);
+  p->player2warriors   = vector<vector<int>>(np);
+  p->player2barricades = vector<vector<Pos>>(np);
+
+  // Until the game closes the pipe.
+  Play_clock clock(1);
+  while (is.peek() != EOF) {
+    State_delta::read(is, *p, true);
+    static_cast<Action*>(p)->clear();
+
+    double cpu  = clock.cpu(0);
+    double wall = clock.wall(0);
+    clock.start();
+    p->play();
+    clock.stop(0);
+
+    msg.str("");
+    write_double(msg, clock.cpu (0) - cpu);
+    write_double(msg, clock.wall(0) - wall);
+    write_varint(msg, p->v.size());
+    for (const Command& c : p->v) {
+      write_signed_varint(msg, c.id);
+      write_signed_varint(msg, c.c_type);
+      write_signed_varint(msg, c.dir);
+    }
+    _my_assert(write_all(out, msg.str(), never), "Cannot write to the game.");
+  }
+
+  delete p;
+}
@@ -0,0 +1,109 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef SecGame_hh
+#define SecGame_hh
+
+
+#include "Player.hh"
+#include "Board.hh"
+#include "Replay.hh"
+#include "State_delta.hh"
+#include "Play_clock.hh"
+
+#include <sys/types.h>
+
+
+/**
+ * Contains the SecGame class, which plays a game with each player
+ * in its own process.
+ */
+
+
+/**
+ * Plays a game where each player is a separate program: the program of
+ * a player is built from its AI and SecGame (make AIName.exe), and is
+ * started by run() with its standard input and file descriptor 3 connected
+ * to pipes, and its standard output sent to the standard error.
+ *
+ * Everything on the pipes is binary. The program first writes the name of
+ * its player. Then it receives its player number, random seed and the
+ * settings, and each round the changes of the state (see State_delta),
+ * to which it answers with the CPU and wall time of Player::play() and
+ * its commands. The changes are encoded once per round for all players.
+ *
+ * A player that crashes, answers wrongly, takes longer than the timeout
+ * to answer or exceeds its CPU budget is dead: it gets status -1 and its
+ * process is killed. Otherwise the output is that of Game::run, and the
+ * same as Game::run for the same players, seed and no budget.
+ */
+class SecGame {
+
+public:
+
+  struct Options {
+    bool   binary;  // Write a binary replay (see Replay) instead of text.
+    bool   quiet;   // Do not log the progress of the match to cerr.
+    double budget;  // CPU seconds each player can spend in Player::play()
+                    // during the match, or 0 for no limit.
+    double timeout; // Seconds each player has to answer in a round, or 0 for the default.
+
+    Options () : binary(false), quiet(false), budget(0), timeout(0) { }
+
+    /**
+     * Seconds each player has to answer in a round: the timeout if given, and
+     * otherwise, with a budget, twice the budget plus a second, so that a player
+     * that blocks without spending its CPU time does not hang the match.
+     * 0 means no limit.
+     */
+    double round_timeout () const {
+      if (timeout > 0 or budget <= 0) return timeout;
+      return 2*budget + 1;
+    }
+  };
+
+  /**
+   * Plays a game with the players run by the given programs, reading the
+   * settings and board from is and writing the game to os.
+   */
+  static void run (const vector<string>& programs, istream& is, ostream& os, int seed,
+                   const Options& opt = Options());
+
+  /**
+   * Plays the only player linked in this program, for a run() that
+   * started it: reads from file descriptor in and writes to out.
+   */
+  static void serve (int in, int out);
+
+private:
+
+  static const string magic;   // Start of what run() sends to each program.
+  static const int    format;  // Version of the protocol.
+
+  /**
+   * Process of a player, and its pipes.
+   */
+  struct Process {
+    pid_t pid;
+    int   to;    // Where the program reads from.
+    int   from;  // Where the program writes to.
+  };
+
+  /**
+   * Starts program with the limits of opt.
+   */
+  static Process start (const string& program, const Options& opt);
+
+  /**
+   * Kills the process p, if it is running, and waits for it.
+   */
+  static void stop (Process& p);
+
+  /**
+   * Reads the answer of a player to a round into a, and the times it
+   * reports. Returns false if it is not well formed or not complete.
+   */
+  static bool read_answer (istream& is, Action& a, double& cpu, double& wall);
+};
+
+
+#endif
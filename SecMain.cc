@@ -0,0 +1,108 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////  
+
+#include "SecGame.hh"
+
+
+void help (int argc, char** argv) {
+  cout << "Usage: " << argv[0] << " [options] program1 program2 ... [< default.cnf] [> default.out] " << endl;
+  cout << "Each program is the path of a player built with make AIName.exe, or just Name for ./AIName.exe" << endl;
+  cout << "Available options:" << endl;
+  cout << "--seed=seed     -s seed     set random seed"                   << endl;
+  cout << "--input=file    -i input    set input file  (default: stdin)"  << endl;
+  cout << "--output=file   -o output   set output file (default: stdout)" << endl;
+  cout << "--binary        -b          write a binary replay (see replay2txt)" << endl;
+  cout << "--quiet         -q          do not log the progress of the game"     << endl;
+  cout << "--budget=t      -t t        CPU seconds per player (default: no limit)" << endl;
+  cout << "--timeout=t     -w t        seconds to answer each round"          << endl;
+  cout << "                            (default: 2*budget + 1 with a budget, no limit otherwise)" << endl;
+  cout << "--version       -v          print version"                     << endl;
+  cout << "--help          -h          print help"                        << endl;
+}
+
+
+int main (int argc, char** argv) {
+  // How SecGame::run starts the program of a player.
+  if (argc == 2 and string(argv[1]) == "--serve") {
+    SecGame::serve(0, 3);
+    return EXIT_SUCCESS;
+  }
+
+  if (argc == 1) {
+    help(argc, argv);
+    return EXIT_SUCCESS;
+  }
+
+  struct option long_options[] = {
+    { "seed",    required_argument, 0, 's' },
+    { "input",   required_argument, 0, 'i' },
+    { "output",  required_argument, 0, 'o' },
+    { "binary",  no_argument,       0, 'b' },
+    { "quiet",   no_argument,       0, 'q' },
+    { "budget",  required_argument, 0, 't' },
+    { "timeout", required_argument, 0, 'w' },
+    { "version", no_argument,       0, 'v' },
+    { "help",    no_argument,       0, 'h' },
+    { 0, 0, 0, 0 }
+  };
+
+  char* ifile = 0;
+  char* ofile = 0;
+  int seed = -1;
+  SecGame::Options opt;
+  vector<string> programs;
+
+  while (true) {
+    int index = 0;
+    int c = getopt_long(argc, argv, "s:i:o:bqt:w:vh", long_options, &index);
+    if (c == -1) break;
+
+    switch (c) {
+      case 's':
+        seed = string_to_int(optarg);
+        break;
+      case 'i':
+        ifile = optarg;
+        break;
+      case 'o':
+        ofile = optarg;
+        break;
+      case 'b':
+        opt.binary = true;
+        break;
+      case 'q':
+        opt.quiet = true;
+        break;
+      case 't':
+        opt.budget = atof(optarg);
+        break;
+      case 'w':
+        opt.timeout = atof(optarg);
+        break;
+      case 'v':
+        cout << Board::version() << endl;
+        cout << "compiled " << __TIME__ << " " << __DATE__ << endl;
+        return EXIT_SUCCESS;
+      case 'h':
+        help(argc, argv);
+        return EXIT_SUCCESS;
+      default:
+        return EXIT_FAILURE;
+    }
+  }
+
+  while (optind < argc) {
+    string program = argv[optind++];
+    if (program.find('/') == string::npos) program = "./AI" + program + ".exe";
+    programs.push_back(program);
+  }
+
+  _my_assert(seed >= 0, "Missing seed?");
+
+  istream* is = ifile ? new ifstream(ifile) : &cin;
+  ostream* os = ofile ? new ofstream(ofile, opt.binary ? ios::binary : ios::out) : &cout;
+
+  SecGame::run(programs, *is, *os, seed, opt);
+
+  if (ifile) delete is;
+  if (ofile) delete os;
+}
@@ -16,7 +16,8 @@ Settings Settings::read_settings (istream& is) {
 
   is >> s >> r.NUM_PLAYERS;
   _my_assert(s == "NUM_PLAYERS", "Expected 'NUM_PLAYERS' while parsing.");
-  _my_assert(r.NUM_PLAYERS == 4, "Wrong NUM_PLAYERS.");
+  _my_assert(r.NUM_PLAYERS >= MIN_PLAYERS and r.NUM_PLAYERS <= MAX_PLAYERS,
+             "NUM_PLAYERS should be in [" + int_to_string(MIN_PLAYERS) + "," + int_to_string(MAX_PLAYERS) + "].");
 
   is >> s >> r.NUM_DAYS;
   _my_assert(s == "NUM_DAYS", "Expected 'NUM_DAYS' while parsing.");
@@ -29,11 +30,13 @@ Settings Settings::read_settings (istream& is) {
 
   is >> s >> r.BOARD_ROWS;
   _my_assert(s == "BOARD_ROWS", "Expected 'BOARD_ROWS' while parsing.");
-  _my_assert(r.BOARD_ROWS >= 12 and r.BOARD_ROWS <= 25, "BOARD_ROWS should be in [12,25].");
+  _my_assert(r.BOARD_ROWS >= MIN_BOARD_SIZE and r.BOARD_ROWS <= MAX_BOARD_SIZE,
+             "BOARD_ROWS should be in [" + int_to_string(MIN_BOARD_SIZE) + "," + int_to_string(MAX_BOARD_SIZE) + "].");
 
   is >> s >> r.BOARD_COLS;
   _my_assert(s == "BOARD_COLS", "Expected 'BOARD_COLS' while parsing.");
-  _my_assert(r.BOARD_COLS >= 12 and r.BOARD_COLS <= 50, "BOARD_COLS should be in [12,50].");
+  _my_assert(r.BOARD_COLS >= MIN_BOARD_SIZE and r.BOARD_COLS <= MAX_BOARD_SIZE,
+             "BOARD_COLS should be in [" + int_to_string(MIN_BOARD_SIZE) + "," + int_to_string(MAX_BOARD_SIZE) + "].");
 
   is >> s >> r.NUM_INI_BUILDERS;
   _my_assert(s == "NUM_INI_BUILDERS", "Expected 'NUM_INI_BUILDERS' while parsing.");
@@ -145,13 +148,72 @@ Settings Settings::read_settings (istream& is) {
 
   is >> s >> r.BARRICADE_MAX_RESISTANCE;
   _my_assert(s == "BARRICADE_MAX_RESISTANCE", "Expected 'BARRICADE_MAX_RESISTANCE' while parsing.");
-  _my_assert(r.BARRICADE_MAX_RESISTANCE >= 1, "Wrong BARRICADE_MAX_RESISTANCE.");
+  _my_assert(r.BARRICADE_MAX_RESISTANCE >= 1 and r.BARRICADE_MAX_RESISTANCE <= SHRT_MAX, "Wrong BARRICADE_MAX_RESISTANCE.");
 
   is >> s >> r.MAX_NUM_BARRICADES;
   _my_assert(s == "MAX_NUM_BARRICADES", "Expected 'MAX_NUM_BARRICADES' while parsing.");
   _my_assert(r.MAX_NUM_BARRICADES >= 1, "Wrong MAX_NUM_BARRICADES.");
 
+#ifdef DEFAULT_RULES
+  // The accessors of this build return the rules of default.cnf.
+  vector<pair<int,int>> rules = {
+    {r.BUILDER_INI_LIFE,          r.builder_ini_life()},
+    {r.WARRIOR_INI_LIFE,          r.warrior_ini_life()},
+    {r.MONEY_POINTS,              r.money_points()},
+    {r.KILL_BUILDER_POINTS,       r.kill_builder_points()},
+    {r.KILL_WARRIOR_POINTS,       r.kill_warrior_points()},
+    {r.FOOD_INCR_LIFE,            r.food_incr_life()},
+    {r.LIFE_LOST_IN_ATTACK,       r.life_lost_in_attack()},
+    {r.BUILDER_STRENGTH_ATTACK,   r.builder_strength_attack()},
+    {r.HAMMER_STRENGTH_ATTACK,    r.hammer_strength_attack()},
+    {r.GUN_STRENGTH_ATTACK,       r.gun_strength_attack()},
+    {r.BAZOOKA_STRENGTH_ATTACK,   r.bazooka_strength_attack()},
+    {r.BUILDER_STRENGTH_DEMOLISH, r.builder_strength_demolish()},
+    {r.HAMMER_STRENGTH_DEMOLISH,  r.hammer_strength_demolish()},
+    {r.GUN_STRENGTH_DEMOLISH,     r.gun_strength_demolish()},
+    {r.BAZOOKA_STRENGTH_DEMOLISH, r.bazooka_strength_demolish()},
+    {r.NUM_ROUNDS_REGEN_BUILDER,  r.num_rounds_regen_builder()},
+    {r.NUM_ROUNDS_REGEN_WARRIOR,  r.num_rounds_regen_warrior()},
+    {r.NUM_ROUNDS_REGEN_FOOD,     r.num_rounds_regen_food()},
+    {r.NUM_ROUNDS_REGEN_MONEY,    r.num_rounds_regen_money()},
+    {r.NUM_ROUNDS_REGEN_WEAPON,   r.num_rounds_regen_weapon()},
+    {r.BARRICADE_RESISTANCE_STEP, r.barricade_resistance_step()},
+    {r.BARRICADE_MAX_RESISTANCE,  r.barricade_max_resistance()},
+    {r.MAX_NUM_BARRICADES,        r.max_num_barricades()}};
+  for (const auto& rule : rules) {
+    _my_assert(rule.first == rule.second, "This build only plays the rules of default.cnf (RULES = 1 in the Makefile).");
+  }
+#endif
+
+  r.WEAPON_STRENGTH_ATTACK[Hammer]     = r.HAMMER_STRENGTH_ATTACK;
+  r.WEAPON_STRENGTH_ATTACK[Gun]        = r.GUN_STRENGTH_ATTACK;
+  r.WEAPON_STRENGTH_ATTACK[Bazooka]    = r.BAZOOKA_STRENGTH_ATTACK;
+  r.WEAPON_STRENGTH_ATTACK[NoWeapon]   = r.BUILDER_STRENGTH_ATTACK;
+  r.WEAPON_STRENGTH_DEMOLISH[Hammer]   = r.HAMMER_STRENGTH_DEMOLISH;
+  r.WEAPON_STRENGTH_DEMOLISH[Gun]      = r.GUN_STRENGTH_DEMOLISH;
+  r.WEAPON_STRENGTH_DEMOLISH[Bazooka]  = r.BAZOOKA_STRENGTH_DEMOLISH;
+  r.WEAPON_STRENGTH_DEMOLISH[NoWeapon] = r.BUILDER_STRENGTH_DEMOLISH;
+  r.CITIZEN_INI_LIFE[Builder]          = r.BUILDER_INI_LIFE;
+  r.CITIZEN_INI_LIFE[Warrior]          = r.WARRIOR_INI_LIFE;
+  r.NUM_ROUNDS_REGEN_CITIZEN[Builder]  = r.NUM_ROUNDS_REGEN_BUILDER;
+  r.NUM_ROUNDS_REGEN_CITIZEN[Warrior]  = r.NUM_ROUNDS_REGEN_WARRIOR;
+
   _my_assert(r.ok(),"Settings invariants not fulfilled.");
+
+  // Identifiers are stored in 16 bits in the grid (see Packed_cell).
+  long long ini_citizens = (long long)r.NUM_PLAYERS*(r.NUM_INI_BUILDERS + r.NUM_INI_WARRIORS);
+  _my_assert(ini_citizens + r.max_new_citizens() <= SHRT_MAX + 1LL,
+             "Too many citizens can be created in a match for their identifiers to fit in the grid.");
   
   return r;
 }
+
+
+long long Settings::max_new_citizens () const {
+  // Each count is capped so that the total cannot overflow, yet any
+  // capped one is already more identifiers than the grid can hold.
+  long long rounds   = (long long)NUM_DAYS*NUM_ROUNDS_PER_DAY;
+  long long builders = min(rounds/NUM_ROUNDS_REGEN_BUILDER, SHRT_MAX + 1LL);
+  long long warriors = min(rounds/NUM_ROUNDS_REGEN_WARRIOR, SHRT_MAX + 1LL);
+  return NUM_PLAYERS*(NUM_INI_BUILDERS*builders + NUM_INI_WARRIORS*warriors);
+}
@@ -255,6 +255,23 @@ private:
   friend class Game;
   friend class SecGame;
   friend class Player;
+  friend class Replay;
+
+  // Limits of the number of players and of the size of the board.
+  // The game is played by 4 players on boards of at most 25x50, but
+  // the engine works with more, e.g. to stress test the players.
+  // (At most 31 players fit in the masks of State_delta.)
+  static const int MIN_PLAYERS    = 2;
+  static const int MAX_PLAYERS    = 16;
+  static const int MIN_BOARD_SIZE = 12;
+  static const int MAX_BOARD_SIZE = 256;
+
+  /**
+   * Returns how many citizens can be created in a match besides the initial
+   * ones: a builder (warrior) is regenerated at most once every
+   * NUM_ROUNDS_REGEN_BUILDER (NUM_ROUNDS_REGEN_WARRIOR) rounds.
+   */
+  long long max_new_citizens () const;
 
   int NUM_PLAYERS;
   int NUM_DAYS;
@@ -294,6 +311,13 @@ private:
   int BARRICADE_RESISTANCE_STEP;
   int BARRICADE_MAX_RESISTANCE;
   int MAX_NUM_BARRICADES;
+
+  // The values above that depend on the weapon or the type of citizen,
+  // indexed by it, so that looking them up needs no switch.
+  int WEAPON_STRENGTH_ATTACK  [NoWeapon + 1];
+  int WEAPON_STRENGTH_DEMOLISH[NoWeapon + 1];
+  int CITIZEN_INI_LIFE        [Warrior + 1];
+  int NUM_ROUNDS_REGEN_CITIZEN[Warrior + 1];
   
   /**
    * Reads the settings from a stream.
@@ -319,6 +343,37 @@ inline int Settings::num_ini_money                () const { return NUM_INI_MONE
 inline int Settings::num_ini_food                 () const { return NUM_INI_FOOD                   ;}
 inline int Settings::num_ini_guns                 () const { return NUM_INI_GUNS                   ;}
 inline int Settings::num_ini_bazookas             () const { return NUM_INI_BAZOOKAS               ;}
+#ifdef DEFAULT_RULES
+
+// Built for the rules of default.cnf (see RULES in the Makefile): these are
+// constants that fold into the engine and the players, and read_settings
+// only accepts settings with the same rules.
+inline int Settings::builder_ini_life             () const { return 60                             ;}
+inline int Settings::warrior_ini_life             () const { return 100                            ;}
+inline int Settings::money_points                 () const { return 5                              ;}
+inline int Settings::kill_builder_points          () const { return 100                            ;}
+inline int Settings::kill_warrior_points          () const { return 250                            ;}
+inline int Settings::food_incr_life               () const { return 20                             ;}
+inline int Settings::life_lost_in_attack          () const { return 20                             ;}
+inline int Settings::builder_strength_attack      () const { return 1                              ;}
+inline int Settings::hammer_strength_attack       () const { return 10                             ;}
+inline int Settings::gun_strength_attack          () const { return 100                            ;}
+inline int Settings::bazooka_strength_attack      () const { return 1000                           ;}
+inline int Settings::builder_strength_demolish    () const { return 3                              ;}
+inline int Settings::hammer_strength_demolish     () const { return 10                             ;}
+inline int Settings::gun_strength_demolish        () const { return 10                             ;}
+inline int Settings::bazooka_strength_demolish    () const { return 30                             ;}
+inline int Settings::num_rounds_regen_builder     () const { return 50                             ;}
+inline int Settings::num_rounds_regen_warrior     () const { return 50                             ;}
+inline int Settings::num_rounds_regen_food        () const { return 10                             ;}
+inline int Settings::num_rounds_regen_money       () const { return 5                              ;}
+inline int Settings::num_rounds_regen_weapon      () const { return 40                             ;}
+inline int Settings::barricade_resistance_step    () const { return 40                             ;}
+inline int Settings::barricade_max_resistance     () const { return 320                            ;}
+inline int Settings::max_num_barricades           () const { return 3                              ;}
+
+#else
+
 inline int Settings::builder_ini_life             () const { return BUILDER_INI_LIFE               ;}
 inline int Settings::warrior_ini_life             () const { return WARRIOR_INI_LIFE               ;}
 inline int Settings::money_points                 () const { return MONEY_POINTS                   ;}
@@ -343,6 +398,11 @@ inline int Settings::barricade_resistance_step    () const { return BARRICADE_RE
 inline int Settings::barricade_max_resistance     () const { return BARRICADE_MAX_RESISTANCE       ;}
 inline int Settings::max_num_barricades           () const { return MAX_NUM_BARRICADES             ;}
 
+#endif
+
+#ifdef DEFAULT_RULES
+
+// Switches on constants, which the compiler turns into constant tables.
 inline int Settings::citizen_ini_life          (CitizenType ct) const {
   switch(ct) {
   case Builder: return builder_ini_life(); break;
@@ -379,6 +439,26 @@ inline int Settings::num_rounds_regen_citizen(CitizenType ci) const {
   }
 }
 
+#else
+
+inline int Settings::citizen_ini_life          (CitizenType ct) const {
+  return unsigned(ct) <= Warrior ? CITIZEN_INI_LIFE[ct] : -1;
+}
+
+inline int Settings::weapon_strength_attack (WeaponType w) const {
+  return unsigned(w) <= NoWeapon ? WEAPON_STRENGTH_ATTACK[w] : -1;
+}
+
+inline int Settings::weapon_strength_demolish (WeaponType w) const {
+  return unsigned(w) <= NoWeapon ? WEAPON_STRENGTH_DEMOLISH[w] : -1;
+}
+
+inline int Settings::num_rounds_regen_citizen(CitizenType ci) const {
+  return unsigned(ci) <= Warrior ? NUM_ROUNDS_REGEN_CITIZEN[ci] : -1;
+}
+
+#endif
+
 inline bool Settings::player_ok (int pl) const {
   return pl >= 0 and pl < num_players();
 }
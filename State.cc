@@ -1,3 +1,19 @@
 //////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////  
 
 #include "State.hh"
+
+
+void State::update (const State& s) {
+  grid.update(s.grid);
+
+  // The rest is small and does not depend on the size of the board.
+  // Assigning to existing vectors reuses their memory.
+  scr               = s.scr;
+  stats             = s.stats;
+  rnd               = s.rnd;
+  day               = s.day;
+  citizens          = s.citizens;
+  player2builders   = s.player2builders;
+  player2warriors   = s.player2warriors;
+  player2barricades = s.player2barricades;
+}
@@ -4,6 +4,8 @@
 
 #include "Structs.hh"
 #include "Settings.hh"
+#include "Grid.hh"
+#include "Citizens.hh"
 
 /**
  * Contains a class to store the current state of a game.
@@ -48,20 +50,20 @@ public:
   Citizen citizen (int id) const;
 
   /**
-   * Returns the ids of the builders of a player.
+   * Returns the ids of the builders of a player, in increasing order.
    */
-  vector<int> builders(int pl) const;
+  const vector<int>& builders(int pl) const;
 
   /**
-   * Returns the ids of the warriors of a player.
+   * Returns the ids of the warriors of a player, in increasing order.
    */
-  vector<int> warriors(int pl) const;
+  const vector<int>& warriors(int pl) const;
 
 
   /**
-   * Returns the positions of the barricades owned by a player.
+   * Returns the positions of the barricades owned by a player, in increasing order.
    */
-  vector<Pos> barricades(int pl) const;
+  const vector<Pos>& barricades(int pl) const;
 
   /**
    * Returns the current score of a player.
@@ -86,24 +88,42 @@ private:
   friend class Game;
   friend class SecGame;
   friend class Player;
+  friend class Replay;
+  friend class State_delta;
 
-  vector< vector<Cell> >   grid;
+  Grid                     grid;
   
   vector<int>              scr; // score of each player
   vector<double>           stats; // -1 -> dead, 0..1 -> % of cpu time limit
   int                      rnd;
   bool                     day;
   
-  map<int, Citizen>        citizens;
-  vector< set<int> >       player2builders;
-  vector< set<int> >       player2warriors;
-  vector< set<Pos> >       player2barricades;
+  Citizens                 citizens;
+  vector< vector<int> >    player2builders;   // Sorted.
+  vector< vector<int> >    player2warriors;   // Sorted.
+  vector< vector<Pos> >    player2barricades; // Sorted.
+
   /**
    * Returns whether id is a valid citizen identifier.
    */
   inline bool citizen_ok (int id) const {
     return citizens.count(id);
   }
+
+  /**
+   * Makes this state equal to s. Only copies the cells of the grid
+   * that changed since this state was last made equal to s.
+   */
+  void update (const State& s);
+
+  /**
+   * Empty list returned for wrong players.
+   */
+  template <typename T>
+  static const vector<T>& nothing () {
+    static const vector<T> v;
+    return v;
+  }
 };
 
 inline int State::round () const {
@@ -119,7 +139,7 @@ inline bool State::is_night () const {
 }
 
 inline Cell State::cell (int i, int j) const {
-  if (i >= 0 and i < (int)grid.size() and j >= 0 and j < (int)grid[i].size())
+  if (i >= 0 and i < grid.rows() and j >= 0 and j < grid.cols())
     return grid[i][j];
   else {
     //cerr << "warning: cell requested for position " << Pos(i, j) << endl;
@@ -132,9 +152,8 @@ inline Cell State::cell (Pos p) const {
 }
 
 inline Citizen State::citizen (int id) const {
-  auto it = citizens.find(id);
-  if (it != citizens.end()) {
-    return it->second;
+  if (citizen_ok(id)) {
+    return citizens[id];
   }
   else {
     //cerr << "warning: citizen requested for identifier " << id << endl;
@@ -142,31 +161,31 @@ inline Citizen State::citizen (int id) const {
   }
 }
 
-inline vector<int> State::builders(int pl) const {
+inline const vector<int>& State::builders(int pl) const {
   if (pl >= 0 and pl < (int) player2builders.size())
-    return vector<int>(player2builders[pl].begin(), player2builders[pl].end());
+    return player2builders[pl];
   else {
     //cerr << "warning: builders requested for player " << pl << endl;
-    return vector<int>();
+    return nothing<int>();
   }
 }
 
 
-inline vector<int> State::warriors(int pl) const {
+inline const vector<int>& State::warriors(int pl) const {
   if (pl >= 0 and pl < (int) player2warriors.size())
-    return vector<int>(player2warriors[pl].begin(), player2warriors[pl].end());
+    return player2warriors[pl];
   else {
     //cerr << "warning: warriors requested for player " << pl << endl;
-    return vector<int>();
+    return nothing<int>();
   }
 }
 
-inline vector<Pos> State::barricades(int pl) const {
+inline const vector<Pos>& State::barricades(int pl) const {
   if (pl >= 0 and pl < (int) player2barricades.size())
-    return vector<Pos>(player2barricades[pl].begin(), player2barricades[pl].end());
+    return player2barricades[pl];
   else {
     //cerr << "warning: barricades requested for player " << pl << endl;
-    return vector<Pos>();
+    return nothing<Pos>();
   }
 }
 
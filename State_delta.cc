@@ -0,0 +1,178 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "State_delta.hh"
+
+
+static bool same_cell (const Packed_cell& a, const Packed_cell& b) {
+  return
+    a.type       == b.type       and
+    a.bonus      == b.bonus      and
+    a.weapon     == b.weapon     and
+    a.b_owner    == b.b_owner    and
+    a.resistance == b.resistance and
+    a.id         == b.id;
+}
+
+static bool same_citizen (const Citizen& a, const Citizen& b) {
+  return
+    a.type   == b.type   and
+    a.id     == b.id     and
+    a.player == b.player and
+    a.pos    == b.pos    and
+    a.weapon == b.weapon and
+    a.life   == b.life;
+}
+
+
+State_delta::State_delta (int rows, int cols, int num_players) :
+  grid(rows, cols),
+  scr(num_players, 0),
+  stats(num_players, 0) { }
+
+
+void State_delta::write (ostream& os, const State& s, bool all_cells) {
+
+  // Cells, by increasing index
+  vector<int> cells;
+  if (all_cells) {
+    cells.resize(s.grid.rows()*s.grid.cols());
+    iota(cells.begin(), cells.end(), 0);
+  }
+  else {
+    cells = s.grid.changes();
+    sort(cells.begin(), cells.end());
+  }
+  int cols = s.grid.cols();
+  const Grid& known = grid;
+  vector<int> changed;
+  for (int k : cells)
+    if (not same_cell(s.grid[k / cols][k % cols], known[k / cols][k % cols])) changed.push_back(k);
+
+  write_varint(os, changed.size());
+  int prev = 0;
+  for (int k : changed) {
+    const Packed_cell& c = s.grid[k / cols][k % cols];
+    write_varint(os, k - prev);
+    os.put(char(c.type));
+    os.put(char(c.bonus));
+    os.put(char(c.weapon));
+    write_signed_varint(os, c.b_owner);
+    write_signed_varint(os, c.resistance);
+    write_signed_varint(os, c.id);
+    grid[k / cols][k % cols] = c;
+    prev = k;
+  }
+
+  // Citizens that died, and citizens that are new or changed
+  vector<int> dead;
+  for (const Citizen& ci : citizens)
+    if (not s.citizens.count(ci.id)) dead.push_back(ci.id);
+  vector<const Citizen*> updated;
+  for (const Citizen& ci : s.citizens)
+    if (not citizens.count(ci.id) or not same_citizen(ci, citizens[ci.id])) updated.push_back(&ci);
+
+  write_varint(os, dead.size());
+  for (int id : dead) {
+    write_varint(os, id);
+    citizens.erase(id);
+  }
+  write_varint(os, updated.size());
+  for (const Citizen* ci : updated) {
+    write_varint(os, ci->id);
+    os.put(char(ci->type));
+    write_varint(os, ci->player);
+    write_varint(os, ci->pos.i);
+    write_varint(os, ci->pos.j);
+    os.put(char(ci->weapon));
+    write_signed_varint(os, ci->life);
+    if (citizens.count(ci->id)) citizens[ci->id] = *ci;
+    else                        citizens.insert(*ci);
+  }
+
+  write_varint(os, s.rnd);
+  os.put(char(s.day));
+
+  // Scores and status, only of the players whose one changed
+  int np = scr.size();
+  int mask = 0;
+  for (int pl = 0; pl < np; ++pl)
+    if (s.scr[pl] != scr[pl]) mask |= 1 << pl;
+  write_varint(os, mask);
+  for (int pl = 0; pl < np; ++pl)
+    if (mask & (1 << pl)) write_signed_varint(os, scr[pl] = s.scr[pl]);
+
+  mask = 0;
+  for (int pl = 0; pl < np; ++pl)
+    if (s.stats[pl] != stats[pl]) mask |= 1 << pl;
+  write_varint(os, mask);
+  for (int pl = 0; pl < np; ++pl)
+    if (mask & (1 << pl)) write_double(os, stats[pl] = s.stats[pl]);
+}
+
+
+void State_delta::read (istream& is, State& s, bool lists) {
+
+  s.grid.forget_changes(); // Only to keep the record of changes short.
+
+  // Builders or warriors of the player of ci, as ci's type.
+  auto list_of = [&s](const Citizen& ci) -> vector<int>& {
+    return ci.type == Builder ? s.player2builders[ci.player] : s.player2warriors[ci.player];
+  };
+
+  int cols = s.grid.cols();
+  int num = read_varint(is);
+  int k = 0;
+  for (int n = 0; n < num; ++n) {
+    k += read_varint(is);
+    _my_assert(k < s.grid.rows()*cols, "Wrong cell in binary stream.");
+    Packed_cell& c = s.grid[k / cols][k % cols];
+    int owner = c.b_owner;
+    c.type       = CellType  (read_byte(is));
+    c.bonus      = BonusType (read_byte(is));
+    c.weapon     = WeaponType(read_byte(is));
+    c.b_owner    = read_signed_varint(is);
+    c.resistance = read_signed_varint(is);
+    c.id         = read_signed_varint(is);
+    if (lists and c.b_owner != owner) {
+      Pos p(k / cols, k % cols);
+      if (owner     != -1) sorted_erase (s.player2barricades[owner],     p);
+      if (c.b_owner != -1) sorted_insert(s.player2barricades[c.b_owner], p);
+    }
+  }
+
+  num = read_varint(is);
+  for (int n = 0; n < num; ++n) {
+    int id = read_varint(is);
+    _my_assert(s.citizens.count(id), "Wrong citizen in binary stream.");
+    if (lists) sorted_erase(list_of(s.citizens[id]), id);
+    s.citizens.erase(id);
+  }
+  num = read_varint(is);
+  for (int n = 0; n < num; ++n) {
+    Citizen ci;
+    ci.id     = read_varint(is);
+    ci.type   = CitizenType(read_byte(is));
+    ci.player = read_varint(is);
+    ci.pos.i  = read_varint(is);
+    ci.pos.j  = read_varint(is);
+    ci.weapon = WeaponType(read_byte(is));
+    ci.life   = read_signed_varint(is);
+    if (s.citizens.count(ci.id)) {
+      if (lists) sorted_erase(list_of(s.citizens[ci.id]), ci.id);
+      s.citizens[ci.id] = ci;
+    }
+    else s.citizens.insert(ci);
+    if (lists) sorted_insert(list_of(ci), ci.id);
+  }
+
+  s.rnd = read_varint(is);
+  s.day = read_byte(is);
+
+  int np = s.scr.size();
+  int mask = read_varint(is);
+  for (int pl = 0; pl < np; ++pl)
+    if (mask & (1 << pl)) s.scr[pl] = read_signed_varint(is);
+  mask = read_varint(is);
+  for (int pl = 0; pl < np; ++pl)
+    if (mask & (1 << pl)) s.stats[pl] = read_double(is);
+}
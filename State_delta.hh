@@ -0,0 +1,50 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef State_delta_hh
+#define State_delta_hh
+
+
+#include "State.hh"
+
+
+/**
+ * Contains the State_delta class, the compact binary encoding of the
+ * changes of a State used by binary replays and by SecGame.
+ */
+
+
+/**
+ * Writes the successive values of a State as what changed since the
+ * previous one: cells, citizens, round, day, scores and status.
+ *
+ * Keeps the state as known by a reader of what has been written so far,
+ * so that only what differs from it is written.
+ */
+class State_delta {
+
+public:
+
+  State_delta (int rows, int cols, int num_players);
+
+  /**
+   * Writes to os what changed in s since the last call, checking only
+   * the changed cells of s's grid (see Grid::changes) unless all_cells.
+   */
+  void write (ostream& os, const State& s, bool all_cells);
+
+  /**
+   * Applies to s the changes written by write. With lists, also keeps
+   * the builders, warriors and barricades of each player up to date.
+   */
+  static void read (istream& is, State& s, bool lists);
+
+private:
+
+  Grid           grid;
+  Citizens       citizens;
+  vector<int>    scr;
+  vector<double> stats;
+};
+
+
+#endif
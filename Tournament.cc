@@ -0,0 +1,100 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#include "Tournament.hh"
+
+
+const double Tournament::K = 16;
+
+
+int Tournament::match_seed (int seed, int k) {
+  // splitmix64 of both, so that close seeds or indices give unrelated games.
+  unsigned long long x = ((unsigned long long)(unsigned)seed << 32) | (unsigned)k;
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  x =  x ^ (x >> 31);
+  return int(x & INT_MAX);
+}
+
+
+Tournament::Tournament (const vector<string>& players, int num_seats, int seed, int rounds) :
+  players(players) {
+
+  int np = players.size();
+  _my_assert(np > 0 and num_seats > 0, "A tournament needs players and seats.");
+
+  // Groups as non-decreasing sequences of player indices, with min(np, num_seats) different ones.
+  vector<vector<int>> groups;
+  vector<int> g(num_seats, 0);
+  while (true) {
+    int different = 1;
+    for (int s = 1; s < num_seats; ++s) different += g[s] != g[s-1];
+    if (different == min(np, num_seats)) groups.push_back(g);
+
+    int s = num_seats - 1;
+    while (s >= 0 and g[s] == np - 1) --s;
+    if (s < 0) break;
+    ++g[s];
+    for (int t = s + 1; t < num_seats; ++t) g[t] = g[s];
+  }
+
+  for (int r = 0; r < rounds; ++r)
+    for (const vector<int>& group : groups)
+      for (int rot = 0; rot < num_seats; ++rot) {
+        vector<string> names;
+        for (int s = 0; s < num_seats; ++s) names.push_back(players[group[(s + rot) % num_seats]]);
+        schedule.push_back(Runner::Match(names, match_seed(seed, schedule.size())));
+      }
+}
+
+
+vector<Tournament::Standing> Tournament::play (const Runner& runner) const {
+  vector<Game::Result> results = runner.run(schedule);
+
+  map<string, Standing> st;
+  for (const string& name : players) st[name] = Standing{ name, 1500, 0, 0, 0 };
+
+  for (int k = 0; k < (int)schedule.size(); ++k) {
+    const vector<string>& names = schedule[k].names;
+    const Game::Result&   r     = results[k];
+    int ns = names.size();
+
+    // Each pair of seats of different players is a game, all with the ratings before the match.
+    map<string, double> delta;
+    for (int a = 0; a < ns; ++a)
+      for (int b = a + 1; b < ns; ++b)
+        if (names[a] != names[b]) {
+          double expected = 1/(1 + pow(10, (st[names[b]].elo - st[names[a]].elo)/400));
+          double actual   = r.score[a] > r.score[b] ? 1 : r.score[a] == r.score[b] ? 0.5 : 0;
+          delta[names[a]] += K*(actual - expected);
+          delta[names[b]] -= K*(actual - expected);
+        }
+    for (const auto& d : delta) st[d.first].elo += d.second;
+
+    for (int s = 0; s < ns; ++s) {
+      Standing& x = st[names[s]];
+      ++x.games;
+      x.score += r.score[s];
+    }
+    for (int s : r.winners) st[names[s]].wins += 1.0/r.winners.size();
+  }
+
+  vector<Standing> res;
+  for (auto& x : st) {
+    if (x.second.games) x.second.score /= x.second.games;
+    res.push_back(x.second);
+  }
+  stable_sort(res.begin(), res.end(), [](const Standing& a, const Standing& b) { return a.elo > b.elo; });
+  return res;
+}
+
+
+void Tournament::print (const vector<Standing>& standings, ostream& os) {
+  os << "rank\tname\telo\tgames\tscore\twins" << '\n';
+  for (int k = 0; k < (int)standings.size(); ++k) {
+    const Standing& x = standings[k];
+    os << k + 1 << '\t' << x.name << '\t'
+       << fixed << setprecision(1) << x.elo << '\t' << x.games << '\t' << x.score << '\t' << x.wins << '\n';
+    os.unsetf(ios::fixed);
+  }
+}
@@ -0,0 +1,82 @@
+//////// STUDENTS DO NOT NEED TO READ BELOW THIS LINE ////////
+
+#ifndef Tournament_hh
+#define Tournament_hh
+
+
+#include "Runner.hh"
+
+
+/**
+ * Contains the Tournament class, a round-robin tournament between players.
+ */
+
+
+/**
+ * Schedules the matches of a round-robin tournament and rates the players
+ * with their results.
+ *
+ * The seed of each match only depends on the seed of the tournament and
+ * the index of the match, and the ratings are computed in the order of the
+ * matches, so the standings do not depend on the number of threads.
+ */
+class Tournament {
+
+public:
+
+  /**
+   * Results of a player in the tournament.
+   */
+  struct Standing {
+    string name;
+    double elo;   // Rating, starting at 1500.
+    int    games; // Seats taken (a player can take several seats of a match).
+    double score; // Mean score per seat.
+    double wins;  // Wins, where a tie for the top score between k seats is 1/k of a win.
+  };
+
+  /**
+   * Schedules the matches between players: each group of num_seats of
+   * them (with repeated players if there are fewer, so that all appear),
+   * in each rotation of the seats, all of it rounds times.
+   */
+  Tournament (const vector<string>& players, int num_seats, int seed, int rounds = 1);
+
+  /**
+   * Returns the matches, in the order of their indices.
+   */
+  const vector<Runner::Match>& matches () const;
+
+  /**
+   * Plays the matches with runner and returns the standings, by decreasing rating.
+   */
+  vector<Standing> play (const Runner& runner) const;
+
+  /**
+   * Prints the standings as a table.
+   */
+  static void print (const vector<Standing>& standings, ostream& os);
+
+  /**
+   * Returns the seed of match k of a tournament with the given seed.
+   */
+  static int match_seed (int seed, int k);
+
+private:
+
+  vector<string>        players;
+  vector<Runner::Match> schedule;
+
+  /**
+   * Elo constant: the most a rating can change in a game against one other seat.
+   */
+  static const double K;
+};
+
+
+inline const vector<Runner::Match>& Tournament::matches () const {
+  return schedule;
+}
+
+
+#endif
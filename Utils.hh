@@ -22,6 +22,11 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <atomic>
+#include <functional>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 #include "Defs.hh"
 
@@ -47,6 +52,33 @@ using namespace std;
 #define _unreachable() { _my_assert(false, "Unreachable code reached."); }
 
 
+/**
+ * Inserts x in the sorted vector v, if it is not already there.
+ */
+template <typename T>
+inline void sorted_insert (vector<T>& v, const T& x) {
+  auto it = lower_bound(v.begin(), v.end(), x);
+  if (it == v.end() or x < *it) v.insert(it, x);
+}
+
+/**
+ * Removes x from the sorted vector v, if it is there.
+ */
+template <typename T>
+inline void sorted_erase (vector<T>& v, const T& x) {
+  auto it = lower_bound(v.begin(), v.end(), x);
+  if (it != v.end() and not (x < *it)) v.erase(it);
+}
+
+/**
+ * Returns whether the sorted vector v contains x.
+ */
+template <typename T>
+inline bool sorted_contains (const vector<T>& v, const T& x) {
+  return binary_search(v.begin(), v.end(), x);
+}
+
+
 /**
  * C++11 to_string gives problems with Cygwin, so this is a replacement.
  */
@@ -74,4 +106,84 @@ inline int string_to_int (const string& s) {
 }
 
 
+/**
+ * Writes x to a binary stream in groups of 7 bits, least significant first
+ * (varint), so that small numbers take a single byte.
+ */
+inline void write_varint (ostream& os, unsigned long long x) {
+  while (x >= 128) {
+    os.put(char(128 | (x & 127)));
+    x >>= 7;
+  }
+  os.put(char(x));
+}
+
+/**
+ * Reads a number written with write_varint.
+ */
+inline unsigned long long read_varint (istream& is) {
+  unsigned long long x = 0;
+  for (int shift = 0; ; shift += 7) {
+    int c = is.get();
+    _my_assert(c != EOF and shift < 64, "Wrong varint in binary stream.");
+    x |= (unsigned long long)(c & 127) << shift;
+    if (c < 128) return x;
+  }
+}
+
+/**
+ * Same for signed numbers, so that small negative numbers also take a single byte.
+ */
+inline void write_signed_varint (ostream& os, long long x) {
+  write_varint(os, x < 0 ? 2*(unsigned long long)(-(x + 1)) + 1 : 2*(unsigned long long)x);
+}
+
+inline long long read_signed_varint (istream& is) {
+  unsigned long long x = read_varint(is);
+  return x & 1 ? -(long long)(x >> 1) - 1 : (long long)(x >> 1);
+}
+
+/**
+ * Writes the 8 bytes of d, least significant first, so that it is read back exactly.
+ */
+inline void write_double (ostream& os, double d) {
+  unsigned long long x;
+  memcpy(&x, &d, 8);
+  for (int k = 0; k < 8; ++k) os.put(char(x >> (8*k)));
+}
+
+inline double read_double (istream& is) {
+  unsigned long long x = 0;
+  for (int k = 0; k < 8; ++k) x |= (unsigned long long)(unsigned char)is.get() << (8*k);
+  _my_assert(is, "Unexpected end of binary stream.");
+  double d;
+  memcpy(&d, &x, 8);
+  return d;
+}
+
+/**
+ * Writes s as its length (varint) followed by its characters.
+ */
+inline void write_string (ostream& os, const string& s) {
+  write_varint(os, s.size());
+  os.write(s.data(), s.size());
+}
+
+inline string read_string (istream& is) {
+  string s(read_varint(is), ' ');
+  is.read(&s[0], s.size());
+  _my_assert(is, "Unexpected end of binary stream.");
+  return s;
+}
+
+/**
+ * Reads a single byte, which must be there.
+ */
+inline int read_byte (istream& is) {
+  int c = is.get();
+  _my_assert(c != EOF, "Unexpected end of binary stream.");
+  return c;
+}
+
+
 #endif
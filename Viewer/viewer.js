@@ -279,6 +279,14 @@ function parseData (raw_data_str) {
 	    data.rounds[round].cpu[i] = (cpu == -100) ? "out" : cpu + "%";
 	}
 	
+	// Pending regenerations (not shown; missing in older game files).
+	if (t[p] == "regeneration") {
+	    p++;
+	    var num_regen = int(t[p++]);
+	    p += 4;             // "kind type player rounds"
+	    p += 4*num_regen;
+	}
+	
 	
 	// Commands.
 	if (round != data.num_rounds) {	    
@@ -0,0 +1,906 @@
+#include "Game.hh"
+
+// Small benchmarks of the engine internals. Run from the directory with default.cnf:
+//   ./bench            runs all benchmarks
+//   ./bench grid ...   runs only the named ones
+//   ./bench golden     checks that Game::run still writes the matches in golden.txt
+//                      byte for byte (only run when named; exits with 1 if any differs)
+
+typedef chrono::steady_clock Clock;
+
+// Every allocation made by the program, to show which code allocates.
+long long allocations = 0;
+
+void* operator new(size_t n) {
+    ++allocations;
+    if (void* p = malloc(n)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+string cnf;   // Contents of default.cnf
+
+double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Returns the time per call of f (in ns): the best of 5 runs of at least 0.05s each
+template <typename F>
+double ns_per_call(F f) {
+    double best = 1e100;
+    for (int run = 0; run < 5; ++run) {
+        long long calls = 0;
+        Clock::time_point start = Clock::now();
+        double elapsed;
+        do {
+            for (int k = 0; k < 10; ++k) f();
+            calls += 10;
+        } while ((elapsed = seconds_since(start)) < 0.05);
+        best = min(best, 1e9*elapsed/calls);
+    }
+    return best;
+}
+
+Board new_board(int seed) {
+    istringstream is(cnf);
+    return Board(is, seed);
+}
+
+// default.cnf with some lines replaced, each one given by its first word
+// (the generator line is the one that starts with RANDOM).
+string cnf_with(const map<string, string>& lines) {
+    istringstream is(cnf);
+    ostringstream os;
+    string line;
+    while (getline(is, line)) {
+        istringstream ls(line);
+        string key;
+        ls >> key;
+        if (lines.count(key)) line = lines.at(key);
+        os << line << '\n';
+    }
+    return os.str();
+}
+
+// Random commands (with rand) for every citizen of b: warriors move, and builders
+// build in a quarter of the cases if builds is set, and move otherwise.
+void random_actions(const Board& b, vector<Action>& act, bool builds = true) {
+    act.assign(b.num_players(), Action());
+    for (int pl = 0; pl < b.num_players(); ++pl) {
+        for (int id : b.builders(pl)) {
+            if (builds and rand()%4 == 0) act[pl].build(id, Dir(rand()%4));
+            else act[pl].move(id, Dir(rand()%4));
+        }
+        for (int id : b.warriors(pl)) act[pl].move(id, Dir(rand()%4));
+    }
+}
+
+// The whole state of b as printed in a game
+string state(const Board& b) {
+    ostringstream os;
+    b.print_state(os);
+    return os.str();
+}
+
+// Returns the allocations per call of f, over calls calls after as many to reach a steady state
+template <typename F>
+double allocations_per_call(F f, int calls = 100) {
+    for (int k = 0; k < calls; ++k) f();
+    long long before = allocations;
+    for (int k = 0; k < calls; ++k) f();
+    return double(allocations - before)/calls;
+}
+
+
+// Full-board scan and copy: flat Grid of Packed_cell vs. the former vector<vector<Cell>>
+void bench_grid() {
+    Board b = new_board(1);
+    long long checksum = 0;
+
+    for (int scale : {1, 4, 8}) {
+        int rows = scale*b.board_rows(), cols = scale*b.board_cols();
+
+        // Same contents in both layouts, tiling the board if needed
+        Grid flat(rows, cols);
+        vector<vector<Cell>> nested(rows, vector<Cell>(cols));
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                flat[i][j] = nested[i][j] = b.cell(i % b.board_rows(), j % b.board_cols());
+
+        // Both scans go through a bounds-checked copy, as State::cell() does
+        auto flat_cell = [&](int i, int j) {
+            const Grid& g = flat;
+            if (i >= 0 and i < g.rows() and j >= 0 and j < g.cols()) return Cell(g[i][j]);
+            return Cell();
+        };
+        auto nested_cell = [&](int i, int j) {
+            if (i >= 0 and i < (int)nested.size() and j >= 0 and j < (int)nested[i].size()) return nested[i][j];
+            return Cell();
+        };
+        auto flat_scan = [&]() {
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < cols; ++j) {
+                    Cell c = flat_cell(i, j);
+                    checksum += c.id + c.resistance + c.bonus;
+                }
+        };
+        auto nested_scan = [&]() {
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < cols; ++j) {
+                    Cell c = nested_cell(i, j);
+                    checksum += c.id + c.resistance + c.bonus;
+                }
+        };
+        // Engine-internal scans read the stored fields directly
+        auto flat_fields = [&]() {
+            const Grid& g = flat;
+            for (int i = 0; i < rows; ++i) {
+                const Packed_cell* row = g[i];
+                for (int j = 0; j < cols; ++j) checksum += row[j].id + row[j].resistance + row[j].bonus;
+            }
+        };
+        auto nested_fields = [&]() {
+            for (int i = 0; i < rows; ++i) {
+                const vector<Cell>& row = nested[i];
+                for (int j = 0; j < cols; ++j) checksum += row[j].id + row[j].resistance + row[j].bonus;
+            }
+        };
+        auto flat_copy = [&]() { const Grid g = flat; checksum += g[rows-1][cols-1].id; };
+        auto nested_copy = [&]() { vector<vector<Cell>> g = nested; checksum += g[rows-1][cols-1].id; };
+
+        cout << "grid " << rows << "x" << cols << endl;
+        cout << "  bytes:  nested " << rows*cols*sizeof(Cell) << "  flat " << rows*cols*sizeof(Packed_cell) << endl;
+        cout << fixed << setprecision(0);
+        cout << "  scan:   nested " << ns_per_call(nested_scan) << " ns  flat " << ns_per_call(flat_scan) << " ns" << endl;
+        cout << "  fields: nested " << ns_per_call(nested_fields) << " ns  flat " << ns_per_call(flat_fields) << " ns" << endl;
+        cout << "  copy:   nested " << ns_per_call(nested_copy) << " ns  flat " << ns_per_call(flat_copy) << " ns" << endl;
+        cout.unsetf(ios::fixed);
+    }
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Per-round handoff of the grid to a player: full copy vs. update with the cells changed in a round
+void bench_handoff() {
+    long long checksum = 0;
+    cout << fixed << setprecision(0);
+    for (int side : {15, 60, 200}) {
+        int rows = side, cols = 2*side;
+        int changes = 2*24*(side/15);  // About two cells per citizen, with citizens growing with the side
+        Grid src(rows, cols), copied, updated;
+        copied = src;
+        updated.update(src);
+
+        int k = 0;
+        auto round = [&]() {   // Changes some cells, as Board::next does
+            src.forget_changes();
+            for (int c = 0; c < changes; ++c, k = (k + 7919) % (rows*cols)) src[k/cols][k%cols].id = c;
+        };
+        auto full = [&]() { round(); copied = src; checksum += copied[0][0].id; };
+        auto delta = [&]() { round(); updated.update(src); checksum += updated[0][0].id; };
+
+        cout << "handoff " << rows << "x" << cols << " (" << changes << " changed cells)" << endl;
+        cout << "  full copy " << ns_per_call(full) << " ns  update " << ns_per_call(delta) << " ns" << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Choice of a regeneration position after some citizens move: scan of the grid vs. Regen_positions
+void bench_regen() {
+    Board b = new_board(1);
+    long long checksum = 0;
+
+    cout << fixed << setprecision(0);
+    for (int scale : {1, 4, 8}) {
+        int rows = scale*b.board_rows(), cols = scale*b.board_cols();
+        Grid g(rows, cols);
+        vector<Pos> citizens;
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j) {
+                g[i][j] = b.cell(i % b.board_rows(), j % b.board_cols());
+                if (g[i][j].id != -1) citizens.push_back(Pos(i, j));
+            }
+        Regen_positions index;
+        index.sync(g);
+
+        auto good = [&](int i, int j) {   // As Board::is_good_pos_to_regen
+            const Grid& cg = g;
+            if (not cg[i][j].is_empty()) return false;
+            for (int ii = max(i - 2, 0); ii <= min(i + 2, rows - 1); ++ii)
+                for (int jj = max(j - 2, 0); jj <= min(j + 2, cols - 1); ++jj)
+                    if (cg[ii][jj].id != -1) return false;
+            return true;
+        };
+        unsigned k = 0;
+        auto round = [&]() {   // Moves every citizen to an adjacent empty cell, if any
+            g.forget_changes();
+            for (Pos& p : citizens) {
+                Dir d = Dir(k++ % 4);
+                Pos q = p + d;
+                const Grid& cg = g;
+                if (q.i < 0 or q.i >= rows or q.j < 0 or q.j >= cols or not cg[q.i][q.j].is_empty()) continue;
+                g[q.i][q.j].id = cg[p.i][p.j].id;
+                g[p.i][p.j].id = -1;
+                p = q;
+            }
+        };
+        auto scan = [&]() {
+            round();
+            vector<Pos> res;
+            for (int i = 0; i < rows; ++i)
+                for (int j = 0; j < cols; ++j)
+                    if (good(i, j)) res.push_back(Pos(i, j));
+            if (not res.empty()) checksum += res[k % res.size()].i;
+        };
+        auto indexed = [&]() {
+            index.sync(g);     // As Board::next does before forgetting the changes
+            round();
+            index.sync(g);
+            if (index.size()) checksum += index.nth(k % index.size()).i;
+        };
+
+        cout << "regen " << rows << "x" << cols << " (" << citizens.size() << " citizens)" << endl;
+        cout << "  scan " << ns_per_call(scan) << " ns  index " << ns_per_call(indexed) << " ns" << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Random draws: the former random() (two steps and a double) against random().
+// Also checks that both give the same numbers.
+struct Old_random {   // Random_generator::random before
+    long long s;
+    Old_random(int seed) : s(seed) { }
+    int random(int l, int u) {
+        s = (843314861*s + 453816693) & ((1LL << 31) - 1);
+        s = (843314861*s + 453816693) & ((1LL << 31) - 1);
+        return l + int((u - l + 1)*(double(s)/(1LL << 31)));
+    }
+};
+
+// Friend of Random_generator, whose seed players cannot set.
+class Bench_random {
+public:
+    static Random_generator seeded(int seed) {
+        Random_generator g;
+        g.set_random_seed(seed);
+        return g;
+    }
+};
+
+void bench_random() {
+    const int n = 1000;
+    for (int seed : {0, 1, 12345, INT_MAX}) {
+        Old_random a(seed);
+        Random_generator b = Bench_random::seeded(seed);
+        for (int range : {1, 2, 30, 1000000})
+            for (int k = 0; k < n; ++k)
+                if (a.random(5, 5 + range - 1) != b.random(5, 5 + range - 1)) {
+                    cerr << "Error: random differs" << endl;
+                    exit(1);
+                }
+    }
+
+    long long checksum = 0;
+    Old_random a(1);
+    Random_generator b = Bench_random::seeded(1);
+    cout << fixed << setprecision(2);
+    cout << "random (ns per draw)" << endl;
+    cout << "  old " << ns_per_call([&]() { for (int k = 0; k < n; ++k) checksum += a.random(0, 99); })/n;
+    cout << "  random " << ns_per_call([&]() { for (int k = 0; k < n; ++k) checksum += b.random(0, 99); })/n << endl;
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Attacks: Board::wins_attack against the former computation with doubles, for every
+// pair of weapons of default.cnf and of strengths up to 100, and every number drawn.
+// Exits with 1 if any outcome differs.
+bool wins_attack_with_doubles(int num, int s1, int s2) {
+    double threshold = double(s1)/(s1 + s2)*Board::ATTACK_M;
+    return num < threshold;
+}
+
+void bench_attack() {
+    Board b = new_board(1);
+    vector<pair<int, int>> strengths;
+    for (int w1 = Hammer; w1 <= NoWeapon; ++w1)
+        for (int w2 = Hammer; w2 <= NoWeapon; ++w2)
+            strengths.push_back({b.weapon_strength_attack(WeaponType(w1)), b.weapon_strength_attack(WeaponType(w2))});
+    int pairings = strengths.size();
+    for (int s1 = 1; s1 <= 100; ++s1)
+        for (int s2 = 1; s2 <= 100; ++s2) strengths.push_back({s1, s2});
+
+    for (const auto& s : strengths)
+        for (int num = 0; num <= Board::ATTACK_M; ++num)
+            if (Board::wins_attack(num, s.first, s.second) != wins_attack_with_doubles(num, s.first, s.second)) {
+                cerr << "Error: attack of strength " << s.first << " against " << s.second
+                     << " with " << num << " differs" << endl;
+                exit(1);
+            }
+
+    long long checksum = 0;
+    int k = 0;
+    auto draw = [&]() { k = k == Board::ATTACK_M ? 0 : k + 1; };
+    cout << "attack (" << pairings << " pairings and " << strengths.size() - pairings << " strengths, "
+         << Board::ATTACK_M + 1 << " draws each, all the same as with doubles)" << endl;
+    cout << fixed << setprecision(2);
+    cout << "  doubles " << ns_per_call([&]() { draw(); checksum += wins_attack_with_doubles(k, 3, 7); })
+         << " ns  integers " << ns_per_call([&]() { draw(); checksum += Board::wins_attack(k, 3, 7); }) << " ns" << endl;
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Commands of a player in a round, given and then handed to the board as Game does:
+// the former Action (a set<int> and a new Action each round) vs. the current one.
+struct Old_action {
+    int q = 0;
+    set<int> u;
+    vector<Command> v;
+    void execute(const Command& m) {
+        ++q;
+        if (u.find(m.id) != u.end()) return;
+        u.insert(m.id);
+        v.push_back(m);
+    }
+};
+
+void bench_action() {
+    cout << fixed << setprecision(0);
+    for (int n : {10, 100, 1000}) {
+        // n commands to citizens spread over the identifiers, a tenth of them repeated
+        vector<int> ids;
+        for (int k = 0; k < n; ++k) ids.push_back(k % 10 == 9 ? ids[k - 1] : 7*k);
+        long long checksum = 0;
+
+        auto old_round = [&]() {
+            Old_action player;                  // Player::reset
+            for (int id : ids) player.execute(Command(id, Move, Down));
+            vector<Old_action> actions(1);      // Game::run
+            actions[0] = player;
+            checksum += actions[0].v.size();
+        };
+        const Action empty;
+        Action player;
+        vector<Action> actions(1);
+        auto new_round = [&]() {
+            player = empty;                     // Player::reset
+            for (int id : ids) player.move(id, Down);
+            actions[0] = player;                // Game::run
+            checksum += &actions[0] != &player;
+        };
+        cout << "action (" << n << " commands)" << endl;
+        cout << "  old " << ns_per_call(old_round) << " ns " << allocations_per_call(old_round) << " allocations"
+             << "  new " << ns_per_call(new_round) << " ns " << allocations_per_call(new_round) << " allocations" << endl;
+        cerr << "(checksum " << checksum << ")" << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
+
+
+// Board generation with the RANDOM generator (retries until the streets are connected)
+// and the FAST one (connected by construction), on the settings of default.cnf and on the largest board
+void bench_generator() {
+    const int seeds = 5000;
+
+    // Whether the cells that are not buildings are connected.
+    auto connected = [](const Board& b) {
+        int rows = b.board_rows(), cols = b.board_cols();
+        vector<char> seen(rows*cols, false);
+        vector<Pos> stack;
+        int free = 0, reached = 0;
+        for (int i = 0; i < rows; ++i)
+            for (int j = 0; j < cols; ++j)
+                if (b.cell(i, j).type != Building) {
+                    ++free;
+                    if (stack.empty() and reached == 0) {
+                        stack.push_back(Pos(i, j));
+                        seen[i*cols + j] = true;
+                    }
+                }
+        while (not stack.empty()) {
+            Pos p = stack.back();
+            stack.pop_back();
+            ++reached;
+            for (Dir d : {Up, Down, Left, Right}) {
+                Pos q = p + d;
+                if (b.pos_ok(q) and b.cell(q).type != Building and not seen[q.i*cols + q.j]) {
+                    seen[q.i*cols + q.j] = true;
+                    stack.push_back(q);
+                }
+            }
+        }
+        return reached == free;
+    };
+
+    cout << fixed << setprecision(1);
+    for (const auto& size : vector<pair<int, int>>{{0, 0}, {25, 50}})
+    for (const string& generator : vector<string>{"RANDOM", "FAST"}) {
+        map<string, string> lines = {{"RANDOM", generator}};
+        if (size.first > 0) {
+            lines["BOARD_ROWS"] = "BOARD_ROWS " + to_string(size.first);
+            lines["BOARD_COLS"] = "BOARD_COLS " + to_string(size.second);
+        }
+        string text = cnf_with(lines);
+        long long attempts = 0, buildings = 0, allocated = 0;
+        int max_attempts = 0;
+        double elapsed = 0;
+        for (int seed = 1; seed <= seeds; ++seed) {
+            istringstream is(text);
+            long long before = allocations;
+            Clock::time_point start = Clock::now();
+            Board b(is, seed);
+            elapsed   += seconds_since(start);
+            allocated += allocations - before;
+            if (seed == 1 and generator == "RANDOM")
+                cout << "generator (" << b.board_rows() << "x" << b.board_cols() << ", " << seeds << " boards)" << endl;
+            attempts += b.num_generation_attempts();
+            max_attempts = max(max_attempts, b.num_generation_attempts());
+            _my_assert(connected(b), "Generated board is not connected.");
+            for (int i = 0; i < b.board_rows(); ++i)
+                for (int j = 0; j < b.board_cols(); ++j) buildings += b.cell(i, j).type == Building;
+        }
+        cout << "  " << generator << " " << 1e6*elapsed/seeds << " us " << double(allocated)/seeds << " allocations per board, "
+             << double(attempts)/seeds << " attempts (at most " << max_attempts << "), "
+             << double(buildings)/seeds << " building cells" << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
+
+
+// Rounds per second as the board and the number of players grow (FAST boards, 20%
+// buildings, a command for every citizen each round, default validation), and
+// the cost per round of printing the state and of its binary delta (see State_delta)
+void bench_scaling() {
+    const int rounds = 100;
+    long long checksum = 0;
+
+    cout << fixed << setprecision(1);
+    cout << "scaling (" << rounds << " rounds)" << endl;
+    cout << "  board     players citizens   rounds/s  us/command   print us  delta us" << endl;
+    for (const auto& size : vector<pair<int, int>>{{15, 30}, {50, 50}, {100, 100}, {200, 200}})
+    for (int players : {4, 16}) {
+        string text = cnf_with({{"RANDOM", "FAST"},
+                                {"NUM_PLAYERS", "NUM_PLAYERS " + to_string(players)},
+                                {"BOARD_ROWS",  "BOARD_ROWS "  + to_string(size.first)},
+                                {"BOARD_COLS",  "BOARD_COLS "  + to_string(size.second)},
+                                {"NUM_DAYS",    "NUM_DAYS 10"}});
+        istringstream is(text);
+        Board b(is, 1);
+        State_delta delta(b.board_rows(), b.board_cols(), b.num_players());
+        ostringstream os;
+        delta.write(os, b, true);
+
+        srand(1);
+        long long commands = 0;
+        double next_time = 0, print_time = 0, delta_time = 0;
+        vector<Action> act;
+        for (int r = 0; r < rounds; ++r) {
+            random_actions(b, act);
+            for (int pl = 0; pl < b.num_players(); ++pl)
+                commands += b.builders(pl).size() + b.warriors(pl).size();
+            Clock::time_point start = Clock::now();
+            b.next(act);
+            next_time += seconds_since(start);
+
+            os.str("");
+            start = Clock::now();
+            b.print_state(os);
+            print_time += seconds_since(start);
+
+            os.str("");
+            start = Clock::now();
+            delta.write(os, b, false);
+            delta_time += seconds_since(start);
+            checksum += os.str().size();
+        }
+        cout << "  " << setw(3) << b.board_rows() << "x" << left << setw(3) << b.board_cols() << right
+             << setw(8) << players << setw(9) << double(commands)/rounds
+             << setw(11) << rounds/next_time << setw(12) << 1e6*next_time/commands
+             << setw(11) << 1e6*print_time/rounds << setw(10) << 1e6*delta_time/rounds << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Board::next alone, every citizen with a command, without validation
+void bench_next() {
+    Board start = new_board(1);
+    start.set_validation(Board::NoValidation);
+    long long checksum = 0;
+
+    // The same rounds each time: random commands to the citizens of each round of a game.
+    vector<Board> boards;
+    vector<vector<Action>> acts;
+    srand(1);
+    for (Board b = start; b.round() < b.num_rounds(); ) {
+        vector<Action> act;
+        random_actions(b, act, false);
+        boards.push_back(b);
+        acts.push_back(act);
+        b.next(act);
+    }
+
+    // The copy of the board that each call needs is measured on its own.
+    int r = 0;
+    Board b = start;
+    auto copy = [&]() {
+        b = boards[r];
+        checksum += b.round();
+        r = (r + 1) % boards.size();
+    };
+    auto next = [&]() {
+        b = boards[r];
+        b.next(acts[r]);
+        checksum += b.round();
+        r = (r + 1) % boards.size();
+    };
+    int rounds = boards.size();
+
+    cout << fixed << setprecision(0);
+    cout << "next (" << start.board_rows() << "x" << start.board_cols() << ", " << rounds << " rounds)" << endl;
+    cout << "  copy " << ns_per_call(copy) << " ns " << allocations_per_call(copy, rounds) << " allocations"
+         << "  copy and next " << ns_per_call(next) << " ns " << allocations_per_call(next, rounds) << " allocations" << endl;
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Board::save and Board::restore vs. a copy of the whole Board, to look one round ahead
+void bench_snapshot() {
+    Board b = new_board(1);
+    b.set_validation(Board::NoValidation);
+    srand(1);
+    vector<Action> act;
+    while (b.round() < b.num_rounds()/2) {
+        random_actions(b, act, false);
+        b.next(act);
+    }
+    random_actions(b, act, false);
+
+    // Simulating the round again after a restore must give the same board.
+    Board::Snapshot s;
+    b.save(s);
+    b.next(act);
+    string after = state(b);
+    b.restore(s);
+    b.next(act);
+    _my_assert(state(b) == after, "Restore does not give the same round.");
+    b.restore(s);
+
+    long long checksum = 0;
+    auto look_ahead_copy = [&]() {
+        Board c = b;
+        c.next(act);
+        checksum += c.score(0);
+    };
+    auto look_ahead_restore = [&]() {
+        b.save(s);
+        b.next(act);
+        checksum += b.score(0);
+        b.restore(s);
+    };
+    auto save_restore = [&]() {
+        b.save(s);
+        b.restore(s);
+    };
+
+    cout << fixed << setprecision(0);
+    cout << "snapshot (" << b.board_rows() << "x" << b.board_cols() << ", round " << b.round() << ")" << endl;
+    cout << "  copy and next " << ns_per_call(look_ahead_copy) << " ns " << allocations_per_call(look_ahead_copy) << " allocations"
+         << "  save, next and restore " << ns_per_call(look_ahead_restore) << " ns " << allocations_per_call(look_ahead_restore) << " allocations" << endl;
+    cout << "  save and restore " << ns_per_call(save_restore) << " ns " << allocations_per_call(save_restore) << " allocations" << endl;
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Board::next with a Board::Journal and Board::undo vs. save and restore, for a search
+void bench_undo() {
+    Board b = new_board(1);
+    b.set_validation(Board::NoValidation);
+    srand(1);
+
+    // From every round, plays up to 4 rounds ahead and undoes them, and then
+    // the round must be the same as in a copy that did not look ahead.
+    const int depth = 4;
+    vector<vector<Action>> acts(depth);
+    vector<Board::Journal> journals(depth);
+    while (b.round() < b.num_rounds()) {
+        Board copy = b;
+        string before = state(b);
+        int d = 0;
+        for (; d < depth and b.round() < b.num_rounds(); ++d) {
+            random_actions(b, acts[d]);
+            b.next(acts[d], journals[d]);
+        }
+        while (d--) b.undo(journals[d]);
+        _my_assert(state(b) == before, "Undo does not give the same board.");
+        _my_assert(b.ok(), "Undo does not keep the invariants.");
+
+        random_actions(b, acts[0]);
+        b.next(acts[0]);
+        copy.next(acts[0]);
+        _my_assert(state(b) == state(copy), "The round after undoing is not the same.");
+    }
+
+    // One round of look-ahead from the middle of a game, on boards of several sizes.
+    long long checksum = 0;
+    cout << fixed << setprecision(0);
+    cout << "undo (one round of look-ahead at the middle of a game, ns and allocations)" << endl;
+    cout << "  board     save, next and restore      next and undo" << endl;
+    for (const auto& size : vector<pair<int, int>>{{15, 30}, {100, 100}, {250, 250}}) {
+        string text = cnf_with({{"RANDOM",     "FAST"},
+                                {"BOARD_ROWS", "BOARD_ROWS " + to_string(size.first)},
+                                {"BOARD_COLS", "BOARD_COLS " + to_string(size.second)}});
+        istringstream is(text);
+        b = Board(is, 1);
+        b.set_validation(Board::NoValidation);
+        while (b.round() < b.num_rounds()/2) {
+            random_actions(b, acts[0]);
+            b.next(acts[0]);
+        }
+        random_actions(b, acts[0]);
+
+        Board::Snapshot s;
+        auto look_ahead_restore = [&]() {
+            b.save(s);
+            b.next(acts[0]);
+            checksum += b.score(0);
+            b.restore(s);
+        };
+        auto look_ahead_undo = [&]() {
+            b.next(acts[0], journals[0]);
+            checksum += b.score(0);
+            b.undo(journals[0]);
+        };
+        cout << "  " << setw(3) << b.board_rows() << "x" << left << setw(3) << b.board_cols() << right
+             << setw(16) << ns_per_call(look_ahead_restore) << setw(5) << allocations_per_call(look_ahead_restore)
+             << setw(16) << ns_per_call(look_ahead_undo)    << setw(5) << allocations_per_call(look_ahead_undo) << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+void bench_validation() {
+    const Board start = new_board(1);
+    long long checksum = 0;
+
+    cout << fixed << setprecision(0);
+    cout << "validation (" << start.board_rows() << "x" << start.board_cols() << ", ns per round)" << endl;
+    vector<pair<string, Board::Validation>> levels = {
+        {"off", Board::NoValidation}, {"incremental", Board::IncrementalValidation}, {"full", Board::FullValidation}};
+    for (const auto& level : levels) {
+        auto game = [&]() {
+            Board b = start;
+            b.set_validation(level.second);
+            srand(1);
+            vector<Action> act;
+            while (b.round() < b.num_rounds()) {
+                random_actions(b, act);
+                b.next(act);
+            }
+            checksum += b.score(0);
+        };
+        cout << "  " << level.first << " " << ns_per_call(game)/start.num_rounds() << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// The same rounds and matches on a fixed set of seeds of default.cnf, to compare a build
+// with the rules read at run time against one with them compiled in (make RULES=1).
+// Both builds play the same games, so they print the same checksum.
+void bench_rules() {
+    const vector<int> seeds = {1, 2, 3, 4, 5, 6, 7, 8};
+    const vector<string> names = {"Eldar", "Eldar", "Eldar", "Eldar"};
+    long long games = 0;    // Of the final scores
+    long long checksum = 0;
+
+    // Random commands to every citizen, so that there are many attacks.
+    vector<Board> boards;
+    vector<vector<Action>> acts;
+    srand(1);
+    for (int seed : seeds) {
+        Board b = new_board(seed);
+        b.set_validation(Board::NoValidation);
+        while (b.round() < b.num_rounds()) {
+            vector<Action> act;
+            random_actions(b, act, false);
+            boards.push_back(b);
+            acts.push_back(act);
+            b.next(act);
+        }
+        for (int pl = 0; pl < b.num_players(); ++pl) games = 31*games + b.score(pl);
+    }
+
+    int r = 0;
+    Board b = boards[0];
+    auto next = [&]() {
+        b = boards[r];
+        b.next(acts[r]);
+        r = (r + 1) % boards.size();
+    };
+    // The lookups of execute and perform_attack on their own, 1000 per call.
+    auto lookups = [&]() {
+        for (int n = 0; n < 1000; ++n) {
+            WeaponType  w = WeaponType(n & 3);
+            CitizenType t = CitizenType((n >> 2) & 1);
+            checksum += b.weapon_strength_attack(w) + b.weapon_strength_demolish(w)
+                      + b.citizen_ini_life(t) + b.num_rounds_regen_citizen(t);
+        }
+    };
+    int k = 0;
+    auto match = [&]() {
+        istringstream is(cnf);
+        Game::play(names, is, seeds[k]);
+        k = (k + 1) % seeds.size();
+    };
+    for (int seed : seeds) {
+        istringstream is(cnf);
+        for (int score : Game::play(names, is, seed).score) games = 31*games + score;
+    }
+
+#ifdef DEFAULT_RULES
+    string rules = "compiled in";
+#else
+    string rules = "read at run time";
+#endif
+    cout << fixed << setprecision(0);
+    cout << "rules (" << rules << ", " << seeds.size() << " seeds, checksum " << games << ")" << endl;
+    cout << "  1000 lookups " << ns_per_call(lookups) << " ns  copy and next " << ns_per_call(next) << " ns";
+    cout << setprecision(2) << "  match " << ns_per_call(match)/1e6 << " ms" << endl;
+    cout.unsetf(ios::fixed);
+    cerr << "(checksum " << checksum << ")" << endl;
+}
+
+
+// Wall time of whole matches of Game::run, written to a file, in each output mode, and of Game::play.
+// The verbose mode logs to stderr, so run with 2>/dev/null (or to a file) to measure that cost.
+void bench_match() {
+    const string file = "bench.out";
+    const vector<string> names = {"Null", "Null", "Null", "Null"};
+    Game::Options verbose, quiet, binary;
+    quiet.quiet = binary.quiet = true;
+    binary.binary = true;
+    vector<pair<string, Game::Options>> modes = {{"text verbose", verbose}, {"text quiet", quiet}, {"binary quiet", binary}};
+
+    cout << fixed << setprecision(2);
+    cout << "match (" << names[0] << " x4, ms per match)" << endl;
+    for (const auto& mode : modes) {
+        int seed = 0;
+        auto match = [&]() {
+            istringstream is(cnf);
+            ofstream os(file, ios::binary);
+            Game::run(names, is, os, ++seed, mode.second);
+        };
+        cout << "  " << mode.first << " " << ns_per_call(match)/1e6 << endl;
+    }
+    int seed = 0;
+    auto headless = [&]() {
+        istringstream is(cnf);
+        Game::play(names, is, ++seed);
+    };
+    cout << "  headless " << ns_per_call(headless)/1e6 << endl;
+    cout.unsetf(ios::fixed);
+    remove(file.c_str());
+}
+
+
+// 64-bit FNV-1a hash of s
+unsigned long long fnv1a(const string& s) {
+    unsigned long long h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// Replays every match of golden.txt with Game::run and compares the hash of its text output.
+// Each line is "<players separated by commas> <cnf file> <seed> <hex digest>"; # starts a comment.
+// The digests were written by the engine that still scheduled the commands of a round with sets
+// and per-round vectors, so any change to the order in which commands are applied shows up here.
+void bench_golden() {
+    ifstream golden("golden.txt");
+    if (not golden) {
+        cerr << "Error: Cannot open golden.txt" << endl;
+        exit(1);
+    }
+    map<string, string> cnfs;
+    int matches = 0, failed = 0;
+    Game::Options quiet;
+    quiet.quiet = true;
+    streambuf* log = cerr.rdbuf();
+    Clock::time_point start = Clock::now();
+    string line;
+    while (getline(golden, line)) {
+        if (line.empty() or line[0] == '#') continue;
+        istringstream ls(line);
+        string players, file, player;
+        int seed;
+        unsigned long long digest;
+        if (not (ls >> players >> file >> seed >> hex >> digest)) {
+            cerr << "Error: Wrong line in golden.txt: " << line << endl;
+            exit(1);
+        }
+        if (not cnfs.count(file)) {
+            ifstream f(file);
+            if (not f) {
+                cerr << "Error: Cannot open " << file << endl;
+                exit(1);
+            }
+            stringstream ss;
+            ss << f.rdbuf();
+            cnfs[file] = ss.str();
+        }
+        vector<string> names;
+        istringstream ps(players);
+        while (getline(ps, player, ',')) names.push_back(player);
+
+        istringstream is(cnfs[file]);
+        ostringstream os;
+        cerr.rdbuf(0);  // The players write to cerr
+        Game::run(names, is, os, seed, quiet);
+        cerr.rdbuf(log);
+        ++matches;
+        if (fnv1a(os.str()) != digest) {
+            ++failed;
+            cout << "  differs: " << players << " " << file << " seed " << seed << endl;
+        }
+    }
+    cout << fixed << setprecision(2);
+    cout << "golden (" << matches << " matches, " << 1e3*seconds_since(start)/max(matches, 1)
+         << " ms per match)" << endl;
+    cout.unsetf(ios::fixed);
+    cout << "  " << matches - failed << " identical, " << failed << " different" << endl;
+    if (failed > 0) exit(1);
+}
+
+
+struct Benchmark {
+    string name;
+    void (*run)();
+    bool   all;   // Whether ./bench without arguments runs it
+};
+
+const vector<Benchmark> benchmarks = {
+    {"grid", bench_grid, true},
+    {"handoff", bench_handoff, true},
+    {"validation", bench_validation, true},
+    {"regen", bench_regen, true},
+    {"generator", bench_generator, true},
+    {"scaling", bench_scaling, true},
+    {"random", bench_random, true},
+    {"attack", bench_attack, true},
+    {"action", bench_action, true},
+    {"next", bench_next, true},
+    {"snapshot", bench_snapshot, true},
+    {"undo", bench_undo, true},
+    {"rules", bench_rules, true},
+    {"match", bench_match, true},
+    {"golden", bench_golden, false},
+};
+
+int main(int argc, char** argv) {
+    ifstream cnf_file("default.cnf");
+    if (not cnf_file) {
+        cerr << "Error: Cannot open default.cnf" << endl;
+        exit(1);
+    }
+    stringstream ss;
+    ss << cnf_file.rdbuf();
+    cnf = ss.str();
+
+    set<string> selected(argv + 1, argv + argc);
+    for (const Benchmark& bm : benchmarks)
+        if (selected.empty() ? bm.all : selected.count(bm.name)) bm.run();
+}
@@ -0,0 +1,12 @@
+#include "Replay.hh"
+
+// Converts a binary replay (written with ./Game --binary) to the text format read by the viewer:
+//   ./replay2txt < game.bin > game.out
+
+int main(int argc, char** argv) {
+    if (argc != 1) {
+        cout << "Usage: " << argv[0] << " < binary_replay > text_replay" << endl;
+        exit(0);
+    }
+    Replay::to_text(cin, cout);
+}
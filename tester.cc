@@ -1,78 +1,134 @@
-#include <iostream>
-#include <fstream>
-#include <cmath>
-#include <unistd.h>
-#include <string>
-#include <sys/wait.h>
-
-using namespace std;
-
-char* my_program;
-char* test_against;
-bool mode_1v3;
+#include "Runner.hh"
 
 const double qnorm_95 = 1.644854;
 
-void run_game(int i) {
-    char command[256];
-    
-    srand(i+rand());
+// Returns true if my_program got the top score and test_against didn't tie with it
+bool won(const Game::Result& r, const vector<string>& names, const string& my_program) {
+    for (int pl : r.winners) {
+        if (names[pl] != my_program) return false;
+    }
+    return not r.winners.empty();
+}
 
-    char* second_player;
-    if (mode_1v3) second_player = test_against;
-    else second_player = my_program;
+// Sequential probability ratio test of H0: win rate p0 against H1: win rate p1,
+// with error rates alpha (accepting H1 when H0 holds) and beta (the opposite)
+struct Sprt {
+    double win, loss;   // Log-likelihood ratio added by a win and by any other result
+    double upper, lower;
+    double llr = 0;
 
-    sprintf(command, "./Game %s %s %s %s < default.cnf > /dev/null 2> /tmp/Auto-tester/out%i.txt -s %i", 
-        my_program, second_player, test_against, test_against, i, rand());
+    Sprt(double p0, double p1, double alpha, double beta) :
+        win(log(p1/p0)), loss(log((1-p1)/(1-p0))),
+        upper(log((1-beta)/alpha)), lower(log(beta/(1-alpha))) { }
 
-    system(command);
-}
+    void add(bool won) { llr += won ? win : loss; }
+    bool decided() const { return llr >= upper or llr <= lower; }
+    bool better() const { return llr >= upper; }
+};
 
 int main(int argc, char** argv) {
     srand (time(NULL));
 
     if (argc < 5) {
-        cout << "Usage: ./tester num_iterations my_player test_against mode" << endl;
+        cout << "Usage: ./tester num_iterations my_player test_against mode [-s] [-j num_threads]" << endl;
+        cout << "                [-sprt [-d delta] [-a alpha] [-b beta]]" << endl;
         cout << "Available modes: 1v3 (test against 25%), 2v2 (test against 50%)" << endl;
+        cout << "-sprt stops as soon as my_player is known to win delta more (default 0.05) than expected," << endl;
+        cout << "or not, with error rates alpha and beta (default 0.05); num_iterations is then the maximum" << endl;
         cout << "Example: ./tester 2000 Eldar My_Old_AI 1v3" << endl;
         exit(0);
     }
 
     int num_iterations = atoi(argv[1]);
-    my_program = argv[2];
-    test_against = argv[3];
+    string my_program = argv[2];
+    string test_against = argv[3];
+    bool mode_1v3;
     if (string(argv[4]) == "1v3") mode_1v3 = true;
     else if (string(argv[4]) == "2v2") mode_1v3 = false;
     else {
         cerr << "Error: Unsupported mode. Supported modes: 1v3 2v2" << endl;
         exit(1);
     }
-    bool silent = (argc > 5 and string(argv[5]) == "-s"); // -s flag used: silence info messages
+    bool silent = false;    // -s flag used: silence info messages
+    int num_threads = 0;    // -j flag: number of games played at the same time (default: one per core)
+    bool sprt = false;      // -sprt flag: stop when the test is decided
+    double delta = 0.05, alpha = 0.05, beta = 0.05;
+    for (int i = 5; i < argc; ++i) {
+        if (string(argv[i]) == "-s") silent = true;
+        else if (string(argv[i]) == "-j" and i+1 < argc) num_threads = atoi(argv[++i]);
+        else if (string(argv[i]) == "-sprt") sprt = true;
+        else if (string(argv[i]) == "-d" and i+1 < argc) delta = atof(argv[++i]);
+        else if (string(argv[i]) == "-a" and i+1 < argc) alpha = atof(argv[++i]);
+        else if (string(argv[i]) == "-b" and i+1 < argc) beta = atof(argv[++i]);
+    }
+    if (sprt and not (delta > 0)) {
+        cerr << "Error: delta must be greater than 0" << endl;
+        exit(1);
+    }
+    if (sprt and not (alpha > 0 and alpha < 0.5 and beta > 0 and beta < 0.5)) {
+        cerr << "Error: alpha and beta must be between 0 and 0.5" << endl;
+        exit(1);
+    }
 
-    system("mkdir /tmp/Auto-tester");
+    ifstream cnf_file("default.cnf");
+    if (not cnf_file) {
+        cerr << "Error: Cannot open default.cnf" << endl;
+        exit(1);
+    }
+    stringstream cnf;
+    cnf << cnf_file.rdbuf();
+
+    string second_player = mode_1v3 ? test_against : my_program;
+    vector<string> names = {my_program, second_player, test_against, test_against};
+
+    vector<Runner::Match> matches;
+    for (int i = 0; i < num_iterations; i++) matches.push_back(Runner::Match(names, rand()));
+
+    Runner runner(cnf.str(), num_threads);
+    if (not silent) cout << "running " << num_iterations << " games on " << runner.num_threads() << " threads..." << endl;
 
-    if (not silent) cout << "running " << num_iterations << " games..." << endl;
+    float expected = 0.5;
+    if (mode_1v3) expected = 0.25;
 
-    for (int i = 0; i < num_iterations; i++) {
-        if (fork() == 0) {
-            run_game(i);
-            exit(i);
-        }
+    if (sprt) {
+        // Results are added in the order of the matches, whatever order they finish in
+        Sprt test(expected, min(expected + delta, 0.99), alpha, beta);
+        vector<int> finished(num_iterations, -1);   // 1 won, 0 not, -1 still playing
+        int added = 0, won_games = 0;
+        vector<Game::Result> results = runner.run(matches, [&](int k, const Game::Result& r) {
+            finished[k] = won(r, names, my_program);
+            while (added < num_iterations and finished[added] != -1 and not test.decided()) {
+                test.add(finished[added]);
+                won_games += finished[added++];
+            }
+            return not test.decided();
+        });
+
+        cout << "WON GAMES: " << won_games << " / " << added << endl;
+        if (test.decided()) cout << (test.better() ? "BETTER" : "NOT BETTER") << endl;
+        else cout << "UNDECIDED" << endl;
+        if (silent) return 0;
+
+        cout << "tested win rate " << 100*(expected + delta) << "% against " << 100*expected << "%, "
+             << "alpha " << alpha << ", beta " << beta << endl;
+        // Matches that were playing when the test was decided also finish, but are not used
+        int played = 0;
+        for (const Game::Result& r : results) played += not r.score.empty();
+        cout << "games played: " << played << " (" << added << " used by the test, "
+             << played - added << " still playing when it was decided, "
+             << num_iterations - played << " saved)" << endl;
+        return 0;
     }
 
-    while (waitpid(-1, NULL, 0) > 0);
+    vector<Game::Result> results = runner.run(matches);
 
-    char buff[128];
-    cout << "WON GAMES: " << flush;
-    sprintf(buff, "grep '%s got top score' /tmp/Auto-tester/out*.txt | wc -l", my_program);
-    system(buff);
+    int won_games = 0;
+    for (const Game::Result& r : results) won_games += won(r, names, my_program);
+    cout << "WON GAMES: " << won_games << endl;
 
-    system("rm -r /tmp/Auto-tester");
     if (silent) return 0; // -s flag: only show results
 
-    float expected = 0.5;
-    if (mode_1v3) expected = 0.25;
     cout << "expected (" << 100*expected << "%): " << num_iterations*expected << endl;
     float standard_error = sqrt(expected * (1-expected) / num_iterations);
     cout << "critical point (better with 95% confidence): " << (qnorm_95*standard_error + expected) * num_iterations << endl;
-}
\ No newline at end of file
+}